@@ -0,0 +1,96 @@
+#pragma once
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "Simd.h"
+
+// Afina 3x4 matrica, red po red (poslednji red je uvek 0 0 0 1 i ne cuva se).
+// Proizvod dve afine je 3 reda x 4 SIMD mnozenja umesto punog 4x4.
+struct Affine
+{
+    glm::vec4 rows[3] = {
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f }
+    };
+
+    glm::mat4 toMat4() const
+    {
+        glm::mat4 m(1.0f);
+        for (int c = 0; c < 4; c++)
+        {
+            m[c][0] = rows[0][c];
+            m[c][1] = rows[1][c];
+            m[c][2] = rows[2][c];
+        }
+        return m;
+    }
+};
+
+// Euler stepeni (pitch x, yaw y, roll z), isti redosled kao ranije: R = Rx * Ry * Rz
+inline glm::quat quatFromEuler(const glm::vec3& degrees)
+{
+    const glm::vec3 r = glm::radians(degrees);
+    return glm::angleAxis(r.x, glm::vec3(1, 0, 0)) *
+        glm::angleAxis(r.y, glm::vec3(0, 1, 0)) *
+        glm::angleAxis(r.z, glm::vec3(0, 0, 1));
+}
+
+inline glm::vec3 eulerFromQuat(const glm::quat& q)
+{
+    const glm::mat3 m = glm::mat3_cast(q);   // m[kolona][red]
+
+    // za R = Rx*Ry*Rz: r02 = sin(y), r12 = -sin(x)cos(y), r22 = cos(x)cos(y), r01 = -cos(y)sin(z)
+    const float sy = glm::clamp(m[2][0], -1.0f, 1.0f);
+    return glm::degrees(glm::vec3(
+        std::atan2(-m[2][1], m[2][2]),
+        std::asin(sy),
+        std::atan2(-m[1][0], m[0][0])));
+}
+
+// T * R * S direktno iz komponenti, bez ijednog mnozenja matrica
+inline void composeAffine(const glm::vec3& t, const glm::quat& q, const glm::vec3& s, Affine& out)
+{
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    out.rows[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * s.x, 2.0f * (xy - wz) * s.y, 2.0f * (xz + wy) * s.z, t.x);
+    out.rows[1] = glm::vec4(2.0f * (xy + wz) * s.x, (1.0f - 2.0f * (xx + zz)) * s.y, 2.0f * (yz - wx) * s.z, t.y);
+    out.rows[2] = glm::vec4(2.0f * (xz - wy) * s.x, 2.0f * (yz + wx) * s.y, (1.0f - 2.0f * (xx + yy)) * s.z, t.z);
+}
+
+// out = a * b (out ne sme biti ni a ni b)
+inline void multiplyAffine(const Affine& a, const Affine& b, Affine& out)
+{
+#if CLAW_SIMD_SSE
+    const __m128 b0 = _mm_loadu_ps(&b.rows[0][0]);
+    const __m128 b1 = _mm_loadu_ps(&b.rows[1][0]);
+    const __m128 b2 = _mm_loadu_ps(&b.rows[2][0]);
+    const __m128 w = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);   // (0, 0, 0, 1)
+
+    for (int i = 0; i < 3; i++)
+    {
+        const glm::vec4& r = a.rows[i];
+        __m128 v = _mm_mul_ps(_mm_set1_ps(r.x), b0);
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(r.y), b1));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(r.z), b2));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(r.w), w));
+        _mm_storeu_ps(&out.rows[i][0], v);
+    }
+#else
+    for (int i = 0; i < 3; i++)
+    {
+        const glm::vec4& r = a.rows[i];
+        out.rows[i] = r.x * b.rows[0] + r.y * b.rows[1] + r.z * b.rows[2] + glm::vec4(0.0f, 0.0f, 0.0f, r.w);
+    }
+#endif
+}
+
+// a -> b za t u [0, 1], element po element: tacno na krajevima i cuva smicanje (deca neuniformno
+// skaliranih roditelja); za rotaciju od jednog koraka simulacije skupljanje je zanemarljivo
+inline void lerpAffine(const Affine& a, const Affine& b, float t, Affine& out)
+{
+    for (int i = 0; i < 3; i++)
+        out.rows[i] = a.rows[i] + (b.rows[i] - a.rows[i]) * t;
+}
@@ -9,15 +9,24 @@
 #include <glm/gtc/constants.hpp>
 
 #include "Scene.h"
+#include "SceneRenderer.h"
+#include "FrameMailbox.h"
 #include "Mesh.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "OitPass.h"
+#include "GLState.h"
 #include "GameObject.h"
 #include "stb_image.h"
 #include "Util.h"
+#include "Prefab.h"
+#include "Name.h"
+#include "Profiler.h"
 #include <thread>
 
 #include <vector>
+#include <algorithm>
+#include <cmath>
 
 
 static float cubeVertices[] = {
@@ -133,295 +142,407 @@ Application::~Application()
 
 void Application::run()
 {
+    // snimanje od pocetka, da uhvati i ucitavanje u init()
+    PROFILE_THREAD("main");
+    if (!m_profilePath.empty())
+        Profiler::instance().setEnabled(true);
+
     init();
 
-    using clock = std::chrono::high_resolution_clock;
+    // isti sat kao vremena dogadjaja u Input-u
+    using clock = Input::Clock;
     auto lastTime = clock::now();
 
-    const float targetFrameTime = 1.0f / 75.0f;
+    // igra i fizika u fiksnim koracima; crtanje interpolira izmedju poslednja dva
+    const float step = 1.0f / (float)m_simulationHz;
+    const unsigned int maxStepsPerFrame = 8;   // posle zastoja (ucitavanje, debugger) ne sustize sve
+    float accumulator = 0.0f;
+
+    // --frames N: trajanje svakog frejma, izvestaj posle poslednjeg
+    const auto runStart = lastTime;
+    m_frameTimes.clear();
+    m_frameTimes.reserve(m_frameLimit);
 
     while (m_running && !m_window.shouldClose())
     {
+        PROFILE_ZONE("frame");
+
+        // cekanje je na pocetku frejma: dogadjaji se citaju posle njega, ne pre
+        if (m_idle)
+        {
+            // nista se ne menja: spava do dogadjaja (ulaz, prozor) ili do sledeceg idle frejma
+            m_window.waitEvents(1.0 / m_idleFps);
+        }
+        else
+        {
+            m_pacer.wait();
+            m_window.pollEvents();
+        }
+
+        // scenario: dogadjaji frejma pre njegovog pocetka, da ih korak ovog frejma primeni
+        if (m_scenario)
+            m_scenario->apply(m_scenarioFrame, m_input);
+
         auto frameStart = clock::now();
         std::chrono::duration<float> dt = frameStart - lastTime;
         lastTime = frameStart;
 
-        update(dt.count());
-        render();
-
-        m_window.swapBuffers();
-        m_window.pollEvents();
+        // ... i tacno jedan korak po frejmu: kretanje ne zavisi od brzine masine
+        if (m_scenario)
+        {
+            dt = std::chrono::duration<float>(step);
+            accumulator = 0.0f;
+        }
 
-        // FRAME LIMITER
-        auto frameEnd = clock::now();
-        std::chrono::duration<float> frameTime = frameEnd - frameStart;
+        // kamera nije deo simulacije: prati brzinu crtanja
+        if (!m_lateLatch)
+            m_camera->processInput(m_input, dt.count());
 
-        if (frameTime.count() < targetFrameTime)
+        accumulator += dt.count();
+        m_simulationSteps = 0;
+        auto updateStart = clock::now();
+        while (accumulator >= step && m_simulationSteps < maxStepsPerFrame)
         {
-            std::this_thread::sleep_for(
-                std::chrono::duration<float>(targetFrameTime - frameTime.count())
-            );
-        }
-    }
-}
+            accumulator -= step;
+            m_simulationSteps++;
 
+            // korak pokriva vreme do (frameStart - ostatak); kasniji dogadjaji cekaju svoj korak
+            m_input.beginStep(frameStart - std::chrono::duration_cast<clock::duration>(
+                std::chrono::duration<float>(accumulator)));
 
-void Application::init()
-{
-    if (!m_window.create(1280, 720, "Claw 3D"))
-    {
-        m_running = false;
-        return;
-    }
+            TransformSystem::instance().storePrevious();
+            update(step);
+            updateLamps();
+            m_scene->update(step);
+        }
+        if (accumulator >= step) accumulator = std::fmod(accumulator, step);
+        const float updateMs = std::chrono::duration<float, std::milli>(clock::now() - updateStart).count();
 
-    glEnable(GL_DEPTH_TEST);
+        const float alpha = accumulator / step;
 
-    m_shader = new Shader("shaders/basic.vert", "shaders/basic.frag");
-    m_camera = new Camera(60.0f, 1280.0f / 720.0f, 0.1f, 100.0f);
-    m_scene = new Scene();
+        // late latching: najsvezije stanje ulaza za kameru, posle (mozda vise) koraka simulacije
+        if (m_lateLatch)
+        {
+            m_window.pollEvents();
+            m_camera->processInput(m_input, dt.count());
+        }
 
-    m_cubeMesh = new Mesh(cubeVertices, 36);
+        // ===== IDLE =====
+        // ista slika kao poslednja nacrtana: bez paketa, crtanja i swap-a (na ekranu ostaje stara)
+        if (!needsRedraw(alpha))
+        {
+            m_input.takeOldestApplied();    // dogadjaj bez vidljive posledice ne ulazi u kasnjenje
+            m_framesSkipped++;
+            if (++m_cleanFrames >= kIdleAfterFrames) m_idle = true;
+        }
+        else
+        {
+            if (m_idle) m_pacer.restart();  // rok se racuna od sada, ne od pre spavanja
+            m_idle = false;
+            m_cleanFrames = 0;
+            rememberDrawn(alpha);
+            drawFrame(alpha);
+        }
 
-    // ===== TEDDY OBJ + TEXTURE =====
-    Mesh* teddyMesh = new Mesh(std::string("models/Teddy.obj"));
-    m_teddyObj = m_scene->createObject(teddyMesh, "Teddy");
-    m_teddyObj->transform.scale = { 0.15f, 0.15f, 0.15f };
-    m_teddyObj->transform.position = { 0.0f, -0.4f, 0.0f };
-    m_teddyObj->texture = loadImageToTexture("models/Teddy.png");
-    m_teddyObj->useTexture = true;
-    m_toys.push_back(m_teddyObj);
+        m_transformCounters = TransformSystem::instance().getCounters();
+        TransformSystem::instance().resetCounters();
 
-    m_coinCursor = loadImageToCursor("Resources/handCursor.png");
-    m_leverCursor = loadImageToCursor("Resources/lever.png");
+        // iskoriscenost niti = zauzeto vreme / trajanje frejma (bez cekanja pacer-a)
+        auto statsEnd = clock::now();
+        m_jobStats = JobSystem::instance().getStats();
+        m_jobStatsMs = std::chrono::duration<float, std::milli>(statsEnd - frameStart).count();
+        JobSystem::instance().resetStats();
 
-    // početno stanje – automat isključen → žeton
-    glfwSetCursor(m_window.getHandle(), m_coinCursor);
-    m_machineOn = false;
+        if (m_frameLimit > 0)
+        {
+            m_frameTimes.push_back(dt.count() * 1000.0f);
+            if (m_frameTimes.size() >= m_frameLimit) m_running = false;
+        }
 
+        if (m_scenario)
+            recordScenarioFrame(m_jobStatsMs, updateMs);
+    }
 
-    // ===== SHEEP OBJ + TEXTURE =====
-    Mesh* sheepMesh = new Mesh(std::string("models/Sheep.obj"));
-    m_sheepObj = m_scene->createObject(sheepMesh, "Sheep");
-    m_sheepObj->transform.scale = { 0.7f, 0.7f, 0.7f };
-    m_sheepObj->transform.position = { 1.0f, -0.5f, 0.8f };
-    m_sheepObj->texture = loadImageToTexture("models/Sheep.png");
-    m_sheepObj->useTexture = true;
-    m_toys.push_back(m_sheepObj);
+    stopRenderThread();
 
+    if (m_frameLimit > 0)
+        printBenchmarkReport(std::chrono::duration<float>(clock::now() - runStart).count());
 
+    if (!m_profilePath.empty())
+        Profiler::instance().writeChromeTrace(m_profilePath);
 
-    // Sphere mesh (lamp)
+    if (m_scenario && !m_scenarioSamples.empty())
     {
-        auto sphere = buildSphereVertices(18, 24);
-        m_sphereMesh = new Mesh(sphere.data(), (unsigned int)(sphere.size() / 6));
+        ScenarioRunInfo info;
+        info.renderer = (const char*)glGetString(GL_RENDERER);
+        info.width = m_window.getWidth();
+        info.height = m_window.getHeight();
+        info.headless = m_window.isHeadless();
+        info.renderThread = m_renderThreadEnabled;
+        info.cabinets = (unsigned int)m_cabinets.size();
+        info.simulationHz = m_simulationHz;
+
+        if (writeScenarioReport(m_scenarioReport, *m_scenario, info, m_scenarioSamples))
+            std::cout << "Scenario: " << m_scenarioSamples.size() << " frejmova -> " << m_scenarioReport << "\n";
     }
+}
 
-    // =====================
-// 1. GLAVNA MASIVNA BAZA
-// =====================
-    float baseWidth = 4.0f;
-    float baseHeight = 1.8f;
-    float baseDepth = 4.5f;
-
-    float holeWidth = 1.2f;
-    float holeHeight = 0.9f;
-    float wallThickness = 0.3f;
-    // Centar rupe (X,Z) u podu stakla: rupa je ostavljena na prednjem delu (dužine holeWidth).
-    m_holeCenter = { 0.0f, m_floorY, (baseDepth * 0.5f) - (holeWidth * 0.5f) };
-    m_holeHalfSize = { holeWidth * 0.5f, holeWidth * 0.5f }; // (x,z) polovine dimenzija otvora
+void Application::recordScenarioFrame(float frameMs, float updateMs)
+{
+    // frejmovi zagrevanja se ne mere
+    if (m_scenarioFrame >= m_scenario->getWarmupFrames())
+    {
+        // sa render niti RenderStats kasni frejm-dva (GL strana crta prethodne pakete)
+        const RenderStats rs = getRenderStats();
+        const FrameStats& fs = m_scene->getStats();
+
+        ScenarioSample sample;
+        sample.frameMs = frameMs;
+        sample.updateMs = updateMs;
+        sample.cullMs = m_cullMs;
+        sample.submitMs = rs.submitMs;
+        sample.drawCalls = rs.drawCalls;
+        sample.objectsDrawn = rs.objectsDrawn;
+        sample.objectsVisible = fs.objectsVisible;
+        sample.objectsCulled = fs.objectsCulled;
+        sample.objectsOccluded = fs.objectsOccluded;
+        sample.glCallsIssued = rs.glCallsIssued;
+        sample.glCallsElided = rs.glCallsElided;
+        m_scenarioSamples.push_back(sample);
+    }
 
-    // LEVA STRANA
-    auto* baseLeft = m_scene->createObject(m_cubeMesh, "BaseLeft");
-    baseLeft->transform.scale = { (baseWidth - holeWidth) / 2.0f, baseHeight, baseDepth };
-    baseLeft->transform.position = { -((holeWidth + baseWidth) / 4.0f), -1.5f, 0.0f };
-    baseLeft->color = { 0.2f, 0.2f, 0.2f };
-
-    // DESNA STRANA
-    auto* baseRight = m_scene->createObject(m_cubeMesh, "BaseRight");
-    baseRight->transform.scale = { (baseWidth - holeWidth) / 2.0f, baseHeight, baseDepth };
-    baseRight->transform.position = { ((holeWidth + baseWidth) / 4.0f), -1.5f, 0.0f };
-    baseRight->color = { 0.2f, 0.2f, 0.2f };
-
-    float upperPartHeight = baseHeight - holeHeight;
-    float upperCenterY = -1.5f + holeHeight / 2.0f;
-
-    // LEVI GORNJI DEO (pod u staklu - levo od rupe)
-    auto* upperLeft = m_scene->createObject(m_cubeMesh, "UpperLeft");
-    upperLeft->transform.scale = {
-        (baseWidth - holeWidth) / 2.0f,
-        upperPartHeight,
-        baseDepth
-    };
-    upperLeft->transform.position = {
-        -((holeWidth + baseWidth) / 4.0f),
-        upperCenterY,
-        0.0f
-    };
-    upperLeft->color = { 0.2f, 0.2f, 0.2f };
-
-    // DESNI GORNJI DEO
-    auto* upperRight = m_scene->createObject(m_cubeMesh, "UpperRight");
-    upperRight->transform.scale = {
-        (baseWidth - holeWidth) / 2.0f,
-        upperPartHeight,
-        baseDepth
-    };
-    upperRight->transform.position = {
-        ((holeWidth + baseWidth) / 4.0f),
-        upperCenterY,
-        0.0f
-    };
-    upperRight->color = { 0.2f, 0.2f, 0.2f };
-
-    // ZADNJI GORNJI DEO (iza rupe)
-    auto* upperBack = m_scene->createObject(m_cubeMesh, "UpperBack");
-    upperBack->transform.scale = {
-        holeWidth,
-        upperPartHeight,
-        (baseDepth - holeWidth)
-    };
-    upperBack->transform.position = {
-        0.0f,
-        upperCenterY,
-        -((holeWidth) / 2.0f)
-    };
-    upperBack->color = { 0.2f, 0.2f, 0.2f };
+    if (++m_scenarioFrame >= m_scenario->getFrameCount())
+        m_running = false;
+}
 
+void Application::setScenario(const std::string& path, const std::string& reportPath)
+{
+    m_scenarioPath = path;
+    m_scenarioReport = reportPath;
+}
 
-    // DONJA IVICA RUPE
-    auto* baseBottomEdge = m_scene->createObject(m_cubeMesh, "BaseBottomEdge");
-    baseBottomEdge->transform.scale = { holeWidth, holeHeight / 5.0f, baseDepth };
-    baseBottomEdge->transform.position = { 0.0f, -1.85f - holeHeight / 2.0f, 0.0f };
-    baseBottomEdge->color = { 0.2f, 0.2f, 0.2f };
+void Application::printBenchmarkReport(float seconds) const
+{
+    if (m_frameTimes.empty()) return;
+
+    std::vector<float> sorted = m_frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](float p) { return sorted[(size_t)(p * (float)(sorted.size() - 1))]; };
+
+    float sum = 0.0f;
+    for (float ms : sorted) sum += ms;
+
+    const RenderStats rs = getRenderStats();
+    std::cout << "===== BENCHMARK =====\n"
+        << (m_window.isHeadless() ? "Headless " : "Prozor ") << m_window.getWidth() << "x" << m_window.getHeight()
+        << ", " << m_cabinets.size() << " automata, " << sorted.size() << " frejmova za " << seconds << " s ("
+        << (seconds > 0.0f ? (float)sorted.size() / seconds : 0.0f) << " FPS)\n"
+        << "Frejm avg/p50/p95/p99/max: " << sum / (float)sorted.size() << " / " << percentile(0.50f) << " / "
+        << percentile(0.95f) << " / " << percentile(0.99f) << " / " << sorted.back() << " ms\n"
+        << "Poslednji frejm: " << rs.drawCalls << " draw poziva, " << rs.objectsDrawn << " objekata, crtanje "
+        << rs.submitMs << " ms";
+    if (m_renderThreadEnabled)
+        std::cout << ", render nit nije nacrtala " << rs.framesDropped;
+    std::cout << "\n";
+}
 
-    // =====================
-// UNUTRAŠNJA PREGRADA (DA SE NE VIDI SPOJ RUPE)
-// =====================
+void Application::drawFrame(float alpha)
+{
+    using clock = Input::Clock;
 
-    float partitionThickness = 0.05f;
-    float partitionHeight = baseHeight * 0.3f;   // skoro cela visina baze
+    if (m_mailbox)
+    {
+        // render nit crta prethodni paket dok se ovaj pravi
+        FramePacket& packet = m_mailbox->beginWrite();
+        buildFrame(packet, alpha);
+        m_mailbox->publish();
+    }
+    else
+    {
+        buildFrame(m_packet, alpha);
 
-    auto* innerPartition = m_scene->createObject(m_cubeMesh, "InnerPartition");
-    innerPartition->transform.scale = { holeWidth, partitionHeight, partitionThickness };
+        auto submitStart = clock::now();
+        renderFrame(m_packet);
+        const float submitMs = std::chrono::duration<float, std::milli>(clock::now() - submitStart).count();
 
-    // malo uvučeno od prednje strane baze
-    innerPartition->transform.position = {
-        0.0f,
-        -0.85f,
-        baseDepth / 2.0f
-    };
+        m_window.swapBuffers();
+        publishRenderStats(m_packet, submitMs);
+    }
+}
 
-    innerPartition->color = { 0.15f, 0.15f, 0.15f };
+void Application::startRenderThread()
+{
+    m_mailbox.reset(new FrameMailbox(m_renderBuffers == 2 ? FrameMailbox::Mode::Double : FrameMailbox::Mode::Triple));
 
+    // kontekst moze biti tekuci na samo jednoj niti; GLFW prozor i dogadjaji ostaju glavnoj
+    glfwMakeContextCurrent(nullptr);
+    m_renderThread = std::thread(&Application::renderThreadLoop, this);
 
-    // GLASS
-    auto* glass = m_scene->createObject(m_cubeMesh, "Glass");
-    glass->transparent = true;
-    glass->transform.scale = { 4.0f, 3.0f, 4.5f };
-    glass->transform.position = { 0.0f, 0.9f, 0.0f };
-    glass->color = { 0.8f, 0.9f, 1.0f };
+    std::cout << "Render thread: " << (m_renderBuffers == 2 ? "double" : "triple") << " buffered\n";
+}
 
-    // LAMP (iznad stakla)
-    m_lamp = m_scene->createObject(m_sphereMesh, "Lamp");
-    m_lamp->transform.scale = { 0.25f, 0.25f, 0.25f };
-    m_lamp->transform.position = { 0.0f, 2.85f, 0.0f };
-    m_lamp->color = { 0.0f, 0.0f, 0.0f };
+void Application::stopRenderThread()
+{
+    if (!m_renderThread.joinable()) return;
 
-    // CLAW ROOT
-    auto* clawRoot = m_scene->createObject(nullptr, "ClawRoot");
-    clawRoot->transform.scale = { 1.5f, 1.5f, 1.5f };
-    clawRoot->transform.position = { 0.0f, 2.5f, 0.0f };
+    m_mailbox->close();
+    m_renderThread.join();
+    m_mailbox.reset();
 
+    // shutdown() brise GL objekte sa glavne niti
+    glfwMakeContextCurrent(m_window.getHandle());
+}
 
-    // VERTICAL ROD
-    auto* verticalRod = m_scene->createObject(m_cubeMesh, "VerticalRod");
-    verticalRod->transform.scale = { 0.1f, 1.0f, 0.1f };
-    verticalRod->transform.position = { 0.0f, -0.6f, 0.0f };
-    verticalRod->color = { 0.2f, 0.2f, 0.2f };
-    clawRoot->addChild(verticalRod);
+void Application::renderThreadLoop()
+{
+    PROFILE_THREAD("render");
+    glfwMakeContextCurrent(m_window.getHandle());
 
-    auto* clawHead = m_scene->createObject(m_cubeMesh, "ClawHead");
-    clawHead->transform.scale = { 0.2f, 0.2f, 0.2f };
-    clawHead->transform.position = { 0.0f, -0.6f, 0.0f };
-    clawHead->color = { 0.6f, 0.6f, 0.6f };
-    verticalRod->addChild(clawHead);
+    using clock = Input::Clock;
+    while (const FramePacket* packet = m_mailbox->acquire())
+    {
+        auto submitStart = clock::now();
+        renderFrame(*packet);
+        const float submitMs = std::chrono::duration<float, std::milli>(clock::now() - submitStart).count();
 
+        m_window.swapBuffers();
+        publishRenderStats(*packet, submitMs);
+    }
 
-    // FINGERS
-    float fingerLength = 1.5f;
-    float fingerThickness = 1.0f;
-    float radius = 0.35f;
+    glfwMakeContextCurrent(nullptr);
+}
 
-    for (int i = 0; i < 3; i++)
+void Application::publishRenderStats(const FramePacket& packet, float submitMs)
+{
+    // posle swapBuffers: najblize trenutku kad frejm stize na ekran sto se moze izmeriti
+    const Input::Clock::time_point presented = Input::Clock::now();
+
+    const RenderStats& drawn = m_renderer->getStats();
+    const unsigned int issued = GLState::getCounters().issued;
+    const unsigned int elided = GLState::getCounters().elided;
+    GLState::resetCounters();
+
+    std::lock_guard<std::mutex> lock(m_renderStatsMutex);
+    RenderStats& stats = m_renderStats;
+    stats.frameIndex = packet.frameIndex;
+    stats.drawCalls = drawn.drawCalls;
+    stats.objectsDrawn = drawn.objectsDrawn;
+    stats.batches = drawn.batches;
+    stats.submitMs = submitMs;
+    stats.glCallsIssued = issued;
+    stats.glCallsElided = elided;
+    stats.framesDropped = m_mailbox ? m_mailbox->getDroppedCount() : 0;
+
+    if (packet.inputTime != Input::Clock::time_point())
     {
-        float angle = glm::radians(120.0f * i);
+        const float latencyMs = std::chrono::duration<float, std::milli>(presented - packet.inputTime).count();
+        stats.inputLatencyMs = latencyMs;
+        stats.inputLatencyMaxMs = std::max(stats.inputLatencyMaxMs, latencyMs);
+        stats.inputLatencySumMs += latencyMs;
+        stats.inputLatencySamples++;
+    }
+}
 
-        auto* finger = m_scene->createObject(m_cubeMesh, "Finger");
+RenderStats Application::getRenderStats() const
+{
+    std::lock_guard<std::mutex> lock(m_renderStatsMutex);
+    return m_renderStats;
+}
 
-        finger->transform.scale = {
-            fingerThickness,
-            fingerLength,
-            fingerThickness
-        };
 
-        finger->transform.position = {
-            cos(angle) * radius,
-            -0.4f,
-            sin(angle) * radius
-        };
+void Application::init()
+{
+    PROFILE_ZONE("init");
 
-        finger->transform.rotation.x = -30.0f;   // nagib ka unutra
-        finger->transform.rotation.y = glm::degrees(angle);
+    const bool created = m_headless
+        ? m_window.createHeadless(m_headlessWidth, m_headlessHeight, "Claw 3D")
+        : m_window.create(1280, 720, "Claw 3D");
+    if (!created)
+    {
+        m_running = false;
+        return;
+    }
 
-        finger->color = { 0.8f, 0.8f, 0.8f };
+    GLState::enable(GL_DEPTH_TEST);
 
-        clawHead->addChild(finger);
-        m_fingers.push_back(finger);
+    // ===== RITAM =====
+    // swap interval vazi za kontekst, pa se postavlja pre nego sto ga preuzme render nit
+    // headless nema prikaza: bez vsync-a, i bez ogranicenja ako ritam nije zadat (merenje)
+    const VSync vsync = m_headless ? VSync::Off : m_window.setVSync(m_vsync);
+    if (vsync != m_vsync)
+        std::cout << (m_headless ? "Headless: vsync se ignorise\n" : "Adaptive vsync nije podrzan, koristi se obican vsync\n");
+    if (m_targetFps < 0.0f)
+        m_targetFps = (m_headless || !m_scenarioPath.empty()) ? 0.0f : (vsync == VSync::Off ? 75.0f : (float)m_window.getRefreshRate());
+    m_pacer.setTargetRate(m_targetFps);
 
-    }
+    m_input.attach(m_window.getHandle());
 
+    if (!m_scenarioPath.empty())
+    {
+        std::unique_ptr<Scenario> scenario(new Scenario());
+        std::string error;
+        if (!scenario->load(m_scenarioPath, error))
+        {
+            std::cerr << error << "\n";
+            m_running = false;
+            return;
+        }
+        m_scenario = std::move(scenario);
+        m_scenarioSamples.reserve(m_scenario->getFrameCount());
+    }
 
-    m_clawRoot = clawRoot;
-    m_grabOffset = { 0.0f, m_clawGrabLocalY, 0.0f };
-    m_clawMinY = m_floorY - m_clawGrabLocalY; 
+    m_shader = new Shader("shaders/basic.vert", "shaders/basic.frag");
+    m_instancedShader = new Shader("shaders/instanced.vert", "shaders/basic.frag");
+    m_oitShader = new Shader("shaders/basic.vert", "shaders/oit_accum.frag");
+    m_bakedShader = new Shader("shaders/baked.vert", "shaders/basic.frag");
 
-    // =====================
-    // 4. RUPA ZA ŽETON (NA PREDNJEM PANELU)
-    // =====================
-    auto* coinSlot = m_scene->createObject(m_cubeMesh, "CoinSlot");
-    coinSlot->transform.scale = { 0.7f, 0.12f, 0.05f };
-    coinSlot->transform.position = { 1.0f, -1.0f, 2.25f };
-    coinSlot->color = { 0.8f, 0.1f, 0.1f };
+    m_oitPass = new OitPass();
+    m_oitPass->init(m_window.getWidth(), m_window.getHeight());
+    m_camera = new Camera(60.0f, (float)m_window.getWidth() / (float)m_window.getHeight(), 0.1f, 100.0f);
+    m_scene = new Scene();
+    m_renderer = new SceneRenderer();
+    m_renderer->setShaders(m_shader, m_instancedShader, m_bakedShader);
+    m_renderer->setOitPass(m_oitPass, m_oitShader);
 
-    m_coinSlotObj = coinSlot;
+    m_cubeMesh = new Mesh(cubeVertices, 36);
 
+    m_coinCursor = loadImageToCursor("Resources/handCursor.png");
+    m_leverCursor = loadImageToCursor("Resources/lever.png");
 
-    // =====================
-    // 5. POLUGA (IZLAZI IZ PREDNJE STRANE BAZE)
-    // =====================
+    // početno stanje – automat isključen → žeton
+    glfwSetCursor(m_window.getHandle(), m_coinCursor);
 
-    // pozicija prednje strane baze
-    float frontZ = baseDepth / 2.0f;
+    // Sphere mesh (lamp)
+    {
+        auto sphere = buildSphereVertices(18, 24);
+        m_sphereMesh = new Mesh(sphere.data(), (unsigned int)(sphere.size() / 6));
+    }
 
-    auto* leverRod = m_scene->createObject(m_cubeMesh, "LeverRod");
-    leverRod->transform.scale = { 0.12f, 0.12f, 0.6f };   // izdužena po Z
-    leverRod->transform.position = {
-        1.6f,           // desna strana
-        -1.2f,          // visina na bazi
-        frontZ + 0.3f   // malo ispred baze
-    };
-    leverRod->color = { 0.15f, 0.15f, 0.15f };
+    // ===== AUTOMATI (prefab scenes/cabinet.txt -> cabinet.scn) =====
+    m_cabinetPrefab = new Prefab();
+    if (!m_cabinetPrefab->load("scenes/cabinet.scn", m_cubeMesh, m_sphereMesh))
+    {
+        m_running = false;
+        return;
+    }
+    spawnCabinets(m_cabinetCount);
 
+    if (!m_cabinets[m_activeCabinet].clawRoot)
+    {
+        std::cerr << "Cabinet prefab has no ClawRoot\n";
+        m_running = false;
+        return;
+    }
 
-    auto* leverHead = m_scene->createObject(m_cubeMesh, "LeverHead");
-    leverHead->transform.scale = { 0.35f, 0.35f, 0.35f };
-    leverHead->transform.position = {
-        1.6f,
-        -1.2f,
-        frontZ + 0.65f
-    };
-    leverHead->color = { 0.9f, 0.1f, 0.1f };
+    // Mere baze moraju da odgovaraju sceni (vidi komentar u scenes/cabinet.txt).
+    float baseDepth = 4.5f;
+    float holeWidth = 1.2f;
+    // Centar rupe (X,Z) u podu stakla: rupa je ostavljena na prednjem delu (dužine holeWidth).
+    m_holeCenter = { 0.0f, m_floorY, (baseDepth * 0.5f) - (holeWidth * 0.5f) };
+    m_holeHalfSize = { holeWidth * 0.5f, holeWidth * 0.5f }; // (x,z) polovine dimenzija otvora
 
+    m_grabOffset = { 0.0f, m_clawGrabLocalY, 0.0f };
+    m_clawMinY = m_floorY - m_clawGrabLocalY; 
 
 
     // ===== WATERMARK =====
@@ -441,8 +562,8 @@ void Application::init()
     glGenVertexArrays(1, &m_watermarkVAO);
     glGenBuffers(1, &m_watermarkVBO);
 
-    glBindVertexArray(m_watermarkVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_watermarkVBO);
+    GLState::bindVertexArray(m_watermarkVAO);
+    GLState::bindArrayBuffer(m_watermarkVBO);
     glBufferData(GL_ARRAY_BUFFER,
         sizeof(watermarkVerts),
         watermarkVerts,
@@ -457,87 +578,115 @@ void Application::init()
         4 * sizeof(float),
         (void*)(2 * sizeof(float)));
 
-    glBindVertexArray(0);
-
     stbi_set_flip_vertically_on_load(true);
     m_watermarkTexture = loadImageToTexture("Resources/Watermark.png");
 
     m_watermarkShader->use();
     m_watermarkShader->setInt("uTex", 0);
 
-
+    // svi GL resursi su napravljeni; odavde GL poziva samo renderFrame()
+    if (m_renderThreadEnabled)
+        startRenderThread();
 }
 
-void Application::update(float dt)
+void Application::spawnCabinets(unsigned int count)
 {
-    m_camera->processInput(m_window.getHandle(), dt);
-    m_scene->update(dt);
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    // mreza iza igraca: automat 0 je u koordinatnom pocetku (kamera kruzi oko njega),
+    // ostali u redu idu naizmenicno desno/levo od njega
+    const float spacing = 7.0f;
+    const unsigned int perRow = (unsigned int)std::ceil(std::sqrt((float)count));
+
+    static const Name toyTag("toy");
+    static const Name fingerTag("finger");
+    static const Name clawRootName("ClawRoot");
+    static const Name lampName("Lamp");
+    static const Name coinSlotName("CoinSlot");
+
+    std::vector<GameObject*> objects;
+    m_cabinets.resize(count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const unsigned int c = i % perRow;
+        const float col = (c % 2 ? 1.0f : -1.0f) * (float)((c + 1) / 2);
+        const float row = (float)(i / perRow);
 
-    static bool lmbDown = false;
-    static bool enterDown = false;
-    static bool backDown = false;
+        objects.clear();
+        Cabinet& cab = m_cabinets[i];
+        cab.root = m_cabinetPrefab->instantiate(*m_scene, { col * spacing, 0.0f, -row * spacing }, 0.0f, &objects);
 
-    static bool lmbPressed = false;
-    // ===== TOGGLE POGLED=====
-    if (glfwGetMouseButton(m_window.getHandle(), GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS)
-    {
-        if (!m_mousePressed)
+        for (GameObject* obj : objects)
         {
-            m_mousePressed = true;
-            m_closeView = !m_closeView;
+            if (obj->hasTag(toyTag)) cab.toys.push_back(obj);
+            if (obj->hasTag(fingerTag)) cab.fingers.push_back(obj);
 
-            if (m_closeView)
-                m_camera->setDistance(7.5f);
-            else
-                m_camera->setDistance(12.0f);
+            if (obj->getName() == clawRootName) cab.clawRoot = obj;
+            else if (obj->getName() == lampName) cab.lamp = obj;
+            else if (obj->getName() == coinSlotName) cab.coinSlot = obj;
         }
     }
-    else
+
+    std::chrono::duration<float, std::milli> ms = std::chrono::high_resolution_clock::now() - t0;
+    std::cout << "Cabinets: " << count << " x " << m_cabinetPrefab->getObjectCount() << " objects in "
+        << ms.count() << " ms\n";
+}
+
+void Application::update(float dt)
+{
+    PROFILE_ZONE("update");
+
+    Cabinet& cab = m_cabinets[m_activeCabinet];
+
+    // ===== TOGGLE POGLED=====
+    if (m_input.wasClicked(GLFW_MOUSE_BUTTON_RIGHT))
     {
-        m_mousePressed = false;
+        m_closeView = !m_closeView;
+
+        if (m_closeView)
+            m_camera->setDistance(7.5f);
+        else
+            m_camera->setDistance(12.0f);
     }
 
 
     float move = m_clawSpeed * dt;
 
     // gasenje
-    if (glfwGetKey(m_window.getHandle(), GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    if (m_input.isDown(GLFW_KEY_ESCAPE))
     {
         glfwSetWindowShouldClose(m_window.getHandle(), true);
     }
 
-    // ===== INPUT EDGES =====
-    bool lmbNow = glfwGetMouseButton(m_window.getHandle(), GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
-    bool lmbClick = lmbNow && !m_lmbDown;
-    m_lmbDown = lmbNow;
-
-    bool spaceNow = glfwGetKey(m_window.getHandle(), GLFW_KEY_SPACE) == GLFW_PRESS;
-    bool spacePress = spaceNow && !m_spaceDown;
-    m_spaceDown = spaceNow;
+    // ===== INPUT EDGES (dogadjaji ovog koraka) =====
+    bool lmbClick = m_input.wasClicked(GLFW_MOUSE_BUTTON_LEFT);
+    bool spacePress = m_input.wasPressed(GLFW_KEY_SPACE);
 
     // ===== VIEW GATE =====
     bool canPlayNow = isFrontPlayable(m_camera->getPosition(), m_closeView);
 
     // ===== OFF -> klik coin slot =====
-    if (m_state == GameState::Off)
+    if (cab.state == GameState::Off)
     {
-        m_lampMode = LampMode::Off;
+        cab.lampMode = LampMode::Off;
 
         if (lmbClick && canPlayNow)
         {
-            m_state = GameState::Playing;
-            m_machineOn = true;
+            cab.state = GameState::Playing;
+            cab.machineOn = true;
 
-            m_lampMode = LampMode::Blue;
+            cab.lampMode = LampMode::Blue;
 
-            m_clawRoot->transform.position.y = m_clawStartY;
-            m_dropping = false;
-            m_returning = false;
+            glm::vec3 rootPos = cab.clawRoot->transform.getPosition();
+            rootPos.y = m_clawStartY;
+            cab.clawRoot->transform.setPosition(rootPos);
+            cab.dropping = false;
+            cab.returning = false;
 
-            m_grabbedToy = nullptr;
-            m_prizeToy = nullptr;
+            cab.grabbedToy = nullptr;
+            cab.prizeToy = nullptr;
 
-            setClawOpen(true);
+            setClawOpen(cab, true);
         }
 
         updateCursor();
@@ -545,33 +694,35 @@ void Application::update(float dt)
     }
 
     // ===== PRIZE BLINK - klik na osvojenu igračku da nestane =====
-    if (m_state == GameState::PrizeBlink)
+    if (cab.state == GameState::PrizeBlink)
     {
-        m_lampMode = LampMode::WinBlink;
+        cab.lampMode = LampMode::WinBlink;
         // ===== LAMP BLINK TIMER =====
-        if (m_lampMode == LampMode::WinBlink)
+        if (cab.lampMode == LampMode::WinBlink)
         {
-            m_lampBlinkTimer += dt;
+            cab.lampBlinkTimer += dt;
 
-            if (m_lampBlinkTimer >= 0.5f)
+            if (cab.lampBlinkTimer >= 0.5f)
             {
-                m_lampBlinkTimer = 0.0f;
-                m_lampBlinkGreen = !m_lampBlinkGreen;
+                cab.lampBlinkTimer = 0.0f;
+                cab.lampBlinkGreen = !cab.lampBlinkGreen;
             }
         }
 
-        if (lmbClick && canPlayNow && m_prizeToy)
+        if (lmbClick && canPlayNow && cab.prizeToy)
         {
-            m_prizeToy->active = false;
+            // osvojena igracka se stvarno unistava (slot u pool-u ide na ponovnu upotrebu)
+            cab.toys.removeSwap(cab.prizeToy);
+            m_scene->destroyObject(cab.prizeToy);
 
-            m_prizeToy = nullptr;
-            m_grabbedToy = nullptr;
-            m_machineOn = false;
+            cab.prizeToy = nullptr;
+            cab.grabbedToy = nullptr;
+            cab.machineOn = false;
 
-            m_lampMode = LampMode::Off;
-            m_state = GameState::Off;
-            m_machineOn = false;
-            setClawOpen(true);
+            cab.lampMode = LampMode::Off;
+            cab.state = GameState::Off;
+            cab.machineOn = false;
+            setClawOpen(cab, true);
 
             return;
         }
@@ -581,27 +732,28 @@ void Application::update(float dt)
 
     /*float move = m_clawSpeed * dt;*/
 
-    if (canPlayNow && (m_state == GameState::Playing || m_state == GameState::Carrying))
+    if (canPlayNow && (cab.state == GameState::Playing || cab.state == GameState::Carrying))
     {
+        glm::vec3 rootPos = cab.clawRoot->transform.getPosition();
 
-        if (glfwGetKey(m_window.getHandle(), GLFW_KEY_A) == GLFW_PRESS)
-            m_clawRoot->transform.position.x -= move;
+        if (m_input.isDown(GLFW_KEY_A))
+            rootPos.x -= move;
 
-        if (glfwGetKey(m_window.getHandle(), GLFW_KEY_D) == GLFW_PRESS)
-            m_clawRoot->transform.position.x += move;
+        if (m_input.isDown(GLFW_KEY_D))
+            rootPos.x += move;
 
-        if (glfwGetKey(m_window.getHandle(), GLFW_KEY_W) == GLFW_PRESS)
-            m_clawRoot->transform.position.z -= move;
+        if (m_input.isDown(GLFW_KEY_W))
+            rootPos.z -= move;
 
-        if (glfwGetKey(m_window.getHandle(), GLFW_KEY_S) == GLFW_PRESS)
-            m_clawRoot->transform.position.z += move;
+        if (m_input.isDown(GLFW_KEY_S))
+            rootPos.z += move;
 
-        m_clawRoot->transform.position.x = glm::clamp(m_clawRoot->transform.position.x, -1.5f, 1.5f);
-        m_clawRoot->transform.position.z = glm::clamp(m_clawRoot->transform.position.z, -1.8f, 1.8f);
-        if (m_state == GameState::Carrying && m_grabbedToy)
+        rootPos.x = glm::clamp(rootPos.x, -1.5f, 1.5f);
+        rootPos.z = glm::clamp(rootPos.z, -1.8f, 1.8f);
+        cab.clawRoot->transform.setPosition(rootPos);   // bez promene -> world matrica ostaje kesirana
+        if (cab.state == GameState::Carrying && cab.grabbedToy)
         {
-            m_grabbedToy->transform.position =
-                m_clawRoot->transform.position + m_grabOffset;
+            cab.grabbedToy->transform.setPosition(rootPos + m_grabOffset);
         }
     }
 
@@ -609,36 +761,36 @@ void Application::update(float dt)
     if (spacePress && canPlayNow)
     {
         // ako nosi igračku - ispusti
-        if (m_state == GameState::Carrying && m_grabbedToy)
+        if (cab.state == GameState::Carrying && cab.grabbedToy)
         {
-            m_state = GameState::ToyFalling;
-            m_toyVelocity = glm::vec3(0.0f); // start padanja
-            setClawOpen(true);
+            cab.state = GameState::ToyFalling;
+            cab.toyVelocity = glm::vec3(0.0f); // start padanja
+            setClawOpen(cab, true);
 
         }
         // ako ne nosi i nije već u drop animaciji - kreni da spušta
-        else if (m_state == GameState::Playing)
+        else if (cab.state == GameState::Playing)
         {
-            m_state = GameState::Dropping;
-            setClawOpen(true);   // prvo otvorena
+            cab.state = GameState::Dropping;
+            setClawOpen(cab, true);   // prvo otvorena
         }
     }
 
-    glm::vec3 clawPos = m_clawRoot->transform.position;
+    glm::vec3 clawPos = cab.clawRoot->transform.getPosition();
 
     // ===== DROPPING =====
-    if (m_state == GameState::Dropping)
+    if (cab.state == GameState::Dropping)
     {
         // SPUŠTAJ KANDZU
-        m_clawRoot->transform.position.y -= m_dropSpeed * dt;
+        glm::vec3 clawPos = cab.clawRoot->transform.getPosition();
+        clawPos.y -= m_dropSpeed * dt;
+        cab.clawRoot->transform.setPosition(clawPos);
 
-        glm::vec3 clawPos = m_clawRoot->transform.position;
-
-        for (GameObject* toy : m_toys)
+        for (GameObject* toy : cab.toys)
         {
             if (!toy || !toy->active) continue;
 
-            glm::vec3 tp = toy->transform.position;
+            glm::vec3 tp = toy->transform.getPosition();
 
             float dx = tp.x - clawPos.x;
             float dz = tp.z - clawPos.z;
@@ -647,246 +799,369 @@ void Application::update(float dt)
             if (distXZ <= m_grabRadius &&
                 std::abs((clawPos.y + m_grabOffset.y) - tp.y) <= 0.25f)
             {
-                m_grabbedToy = toy;
-                m_state = GameState::Returning;
-                setClawOpen(false);
+                cab.grabbedToy = toy;
+                cab.state = GameState::Returning;
+                setClawOpen(cab, false);
                 // odmah je postavi u tačku hvatanja da ne "odleti" ka ClawRoot centru
-                m_grabbedToy->transform.position = m_clawRoot->transform.position + m_grabOffset;
+                cab.grabbedToy->transform.setPosition(clawPos + m_grabOffset);
+                cab.grabbedToy->transform.resetInterpolation();
                 break;
             }
         }
 
         // DOTAKLA DNO
-        if (m_clawRoot->transform.position.y <= m_clawMinY)
+        if (clawPos.y <= m_clawMinY)
         {
-            m_clawRoot->transform.position.y = m_clawMinY;
-            m_state = GameState::Returning;
+            clawPos.y = m_clawMinY;
+            cab.clawRoot->transform.setPosition(clawPos);
+            cab.state = GameState::Returning;
         }
     }
 
 
     // ===== RETURNING =====
-    if (m_state == GameState::Returning)
+    if (cab.state == GameState::Returning)
     {
-        m_clawRoot->transform.position.y += m_dropSpeed * dt;
+        glm::vec3 clawPos = cab.clawRoot->transform.getPosition();
+        clawPos.y += m_dropSpeed * dt;
+        cab.clawRoot->transform.setPosition(clawPos);
 
         // ako nosi igračku, neka ide sa kandzom
-        if (m_grabbedToy)
+        if (cab.grabbedToy)
         {
-            m_grabbedToy->transform.position =
-                m_clawRoot->transform.position + m_grabOffset;
+            cab.grabbedToy->transform.setPosition(clawPos + m_grabOffset);
         }
 
 
-        if (m_clawRoot->transform.position.y >= m_clawStartY)
+        if (clawPos.y >= m_clawStartY)
         {
-            m_clawRoot->transform.position.y = m_clawStartY;
+            clawPos.y = m_clawStartY;
+            cab.clawRoot->transform.setPosition(clawPos);
 
-            if (m_grabbedToy)
-                m_state = GameState::Carrying;
+            if (cab.grabbedToy)
+                cab.state = GameState::Carrying;
             else
-                m_state = GameState::Playing;
+                cab.state = GameState::Playing;
         }
     }
 
     // ===== PADANNJE IGRACKE =====
-    if (m_state == GameState::ToyFalling && m_grabbedToy)
+    if (cab.state == GameState::ToyFalling && cab.grabbedToy)
     {
-        m_toyVelocity.y -= 9.8f * dt;
-
-        m_grabbedToy->transform.position += m_toyVelocity * dt;
+        cab.toyVelocity.y -= 9.8f * dt;
 
-        glm::vec3 p = m_grabbedToy->transform.position;
+        glm::vec3 p = cab.grabbedToy->transform.getPosition() + cab.toyVelocity * dt;
+        cab.grabbedToy->transform.setPosition(p);
 
         bool inHole = pointInHoleXZ(p, m_holeCenter, m_holeHalfSize);
         if (inHole && p.y <= m_floorY)
         {
             // Ušla je u fizički otvor → teleport u pregradu za nagradu i prebaci stanje
-            m_grabbedToy->transform.position = m_prizePos;
+            cab.grabbedToy->transform.setPosition(m_prizePos);
+            cab.grabbedToy->transform.resetInterpolation();
 
-            m_prizeToy = m_grabbedToy;
-            m_grabbedToy = nullptr;
+            cab.prizeToy = cab.grabbedToy;
+            cab.grabbedToy = nullptr;
 
-            m_lampMode = LampMode::WinBlink;
-            m_lampBlinkTimer = 0.0f;
-            m_lampBlinkGreen = true;
+            cab.lampMode = LampMode::WinBlink;
+            cab.lampBlinkTimer = 0.0f;
+            cab.lampBlinkGreen = true;
 
-            m_state = GameState::PrizeBlink;
+            cab.state = GameState::PrizeBlink;
         }
         else if (!inHole && p.y <= m_floorY)
         {
             float halfH = 0.2f;
 
-            if (m_grabbedToy == m_teddyObj)
+            if (cab.grabbedToy->getName() == Name("Teddy"))
                 halfH = m_teddyHalfHeight;
-            else if (m_grabbedToy == m_sheepObj)
+            else if (cab.grabbedToy->getName() == Name("Sheep"))
                 halfH = m_sheepHalfHeight;
 
             p.y = m_floorY + halfH;
 
           
-            m_grabbedToy->transform.position = p;
+            cab.grabbedToy->transform.setPosition(p);
 
-            m_toyVelocity = glm::vec3(0.0f);
-            m_state = GameState::Playing;
-            m_grabbedToy = nullptr;
+            cab.toyVelocity = glm::vec3(0.0f);
+            cab.state = GameState::Playing;
+            cab.grabbedToy = nullptr;
         }
     }
 
 
     // DEPTH toggle
-    if (glfwGetKey(m_window.getHandle(), GLFW_KEY_1) == GLFW_PRESS)
+    if (m_input.wasPressed(GLFW_KEY_1))
     {
-        if (!m_dPressed)
-        {
-            m_dPressed = true;
-            m_depthEnabled = !m_depthEnabled;
+        m_depthEnabled = !m_depthEnabled;
+    }
 
-            if (m_depthEnabled)
-                glEnable(GL_DEPTH_TEST);
-            else
-                glDisable(GL_DEPTH_TEST);
-        }
+    // CULL toggle
+    if (m_input.wasPressed(GLFW_KEY_2))
+    {
+        m_cullEnabled = !m_cullEnabled;
     }
-    else
+
+    // RENDER PATH toggle (classic <-> batched)
+    if (m_input.wasPressed(GLFW_KEY_3))
     {
-        m_dPressed = false;
+        bool batched = m_scene->getRenderPath() == RenderPath::Classic;
+        m_scene->setRenderPath(batched ? RenderPath::Batched : RenderPath::Classic);
+
+        std::cout << "Render path: " << (batched ? "batched" : "classic")
+            << " (prethodni frejm: " << getRenderStats().drawCalls << " draw poziva)\n";
     }
 
-    // CULL toggle
-    if (glfwGetKey(m_window.getHandle(), GLFW_KEY_2) == GLFW_PRESS)
+    // ispis statistike prethodnog frejma
+    if (m_input.wasPressed(GLFW_KEY_F1))
     {
-        if (!m_cPressed)
-        {
-            m_cPressed = true;
-            m_cullEnabled = !m_cullEnabled;
+        printFrameStats();
+    }
 
-            if (m_cullEnabled)
-            {
-                glEnable(GL_CULL_FACE);
-                glCullFace(GL_BACK);
-            }
-            else
-            {
-                glDisable(GL_CULL_FACE);
-            }
-        }
+    // snimak profajlera do sada (--profile), snimanje se nastavlja
+    if (m_input.wasPressed(GLFW_KEY_F5) && !m_profilePath.empty())
+    {
+        Profiler::instance().writeChromeTrace(m_profilePath);
+        Profiler::instance().setEnabled(true);
     }
-    else
+
+    // OIT toggle (weighted blended <-> obican alpha blend)
+    if (m_input.wasPressed(GLFW_KEY_4))
     {
-        m_cPressed = false;
+        m_scene->setOitEnabled(!m_scene->getOitEnabled());
+
+        std::cout << "Transparency: " << (m_scene->getOitEnabled() ? "weighted blended OIT" : "alpha blend") << "\n";
     }
     updateCursor();
 
 }
-void Application::setClawOpen(bool open)
+void Application::setClawOpen(Cabinet& cab, bool open)
 {
-    m_clawOpen = open;
+    cab.clawOpen = open;
 
     // Vizuelno: otvorena = šire i više "rascvetana", zatvorena = skupljena ka centru
     float pitch = open ? -60.0f : -15.0f;   // nagib prstiju
     float radius = open ? 0.55f : 0.22f;   // udaljenost prstiju od centra
 
-    for (GameObject* finger : m_fingers)
+    for (GameObject* finger : cab.fingers)
     {
         if (!finger) continue;
 
-        float yawDeg = finger->transform.rotation.y;          // već postavljen u init
+        float yawDeg = finger->transform.getRotation().y;          // već postavljen u init
         float a = glm::radians(yawDeg);
 
-        finger->transform.position.x = cos(a) * radius;
-        finger->transform.position.z = sin(a) * radius;
-        finger->transform.position.y = -0.4f;
-
-        finger->transform.rotation.x = pitch;
+        finger->transform.setPosition({ cos(a) * radius, -0.4f, sin(a) * radius });
+        finger->transform.setRotation({ pitch, yawDeg, 0.0f });
     }
 }
 
 void Application::updateCursor()
 {
-    if (m_state == GameState::Off) glfwSetCursor(m_window.getHandle(), m_coinCursor);
+    if (m_cabinets[m_activeCabinet].state == GameState::Off) glfwSetCursor(m_window.getHandle(), m_coinCursor);
     else                           glfwSetCursor(m_window.getHandle(), m_leverCursor);
 }
 
-void Application::render()
+void Application::printFrameStats() const
 {
-    glClearColor(0.7f, 0.85f, 1.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    const FrameStats& st = m_scene->getStats();
+    const RenderStats rs = getRenderStats();
+
+    std::cout << "===== FRAME STATS =====\n"
+        << "draw pozivi: " << rs.drawCalls << " (batch: " << rs.batches << "), objekata: " << rs.objectsDrawn
+        << ", crtanje " << rs.submitMs << " ms\n"
+        << "objekata: " << st.objectsLive << " zivih, unisteno " << st.objectsDestroyedTotal
+        << ", vraceno blokova " << st.poolSlabsReleasedTotal << " (od pokretanja)\n"
+        << "vidljivo: " << st.objectsVisible << ", frustum: " << st.objectsCulled
+        << ", okludirano: " << st.objectsOccluded << " (" << st.occlusionMs << " ms)\n"
+        << "staticki batch: " << st.staticObjectsBaked << " objekata" << (st.staticBatchRebuilt ? " (ponovo pecen)" : "") << "\n"
+        << "BVH build/refit/rebuild: " << st.bvhBuildMs << " / " << st.bvhRefitMs << " / " << st.bvhRebuildMs << " ms\n"
+        << "GL stanje: izdato " << rs.glCallsIssued << ", preskoceno " << rs.glCallsElided << "\n"
+        << "Transform: world racunato " << m_transformCounters.worldRecomputed
+        << " (lokalno " << m_transformCounters.localRecomputed << "), iz kesa " << m_transformCounters.cacheHits
+        << ", cvorova " << TransformSystem::instance().getNodeCount() << "\n"
+        << "Simulacija: " << m_simulationHz << " Hz, koraka u frejmu " << m_simulationSteps << "\n";
+
+    const FramePacer::Report pacing = m_pacer.getReport();
+    std::cout << "Ritam: cilj " << m_pacer.getTargetRate() << " FPS, kasnjenje budjenja p50/p95/p99/max "
+        << pacing.p50Ms << " / " << pacing.p95Ms << " / " << pacing.p99Ms << " / " << pacing.maxMs
+        << " ms (" << pacing.frames << " frejmova, propusteno " << pacing.missed
+        << "), spin margina " << pacing.spinMarginMs << " ms\n";
+    if (m_idleFps > 0.0f)
+        std::cout << "Idle: nacrtano " << m_frameIndex << ", preskoceno " << m_framesSkipped
+            << " frejmova" << (m_idle ? " (miruje)" : "") << "\n";
+
+    for (size_t i = 0; i < m_jobStats.size(); i++)
+    {
+        const JobSystem::WorkerStats& w = m_jobStats[i];
+        std::cout << "Jobs nit " << i << (i == 0 ? " (glavna)" : "") << ": " << w.jobs << " poslova ("
+            << w.stolen << " ukradeno), zauzeto " << (m_jobStatsMs > 0.0f ? 100.0f * w.busyMs / m_jobStatsMs : 0.0f) << "%\n";
+    }
 
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
-    // ===== LAMP = svetlo na sceni =====
-    glm::vec3 lampColor{ 0.0f };
-    switch (m_lampMode)
+    if (rs.inputLatencySamples > 0)
     {
-    case LampMode::Off:
-        lampColor = { 1.0f, 1.0f, 1.0f };
-        break;
-    case LampMode::Blue:
-        lampColor = { 0.1f, 0.35f, 1.0f };
-        break;
-    case LampMode::WinBlink:
-        lampColor = m_lampBlinkGreen ? glm::vec3(0.1f, 1.0f, 0.2f) : glm::vec3(1.0f, 0.15f, 0.15f);
-        break;
+        std::cout << "Ulaz -> ekran: poslednji " << rs.inputLatencyMs << " ms, prosek "
+            << rs.inputLatencySumMs / (float)rs.inputLatencySamples << " ms, max " << rs.inputLatencyMaxMs
+            << " ms (" << rs.inputLatencySamples << " uzoraka";
+        if (m_input.getDroppedCount() > 0) std::cout << ", izgubljeno dogadjaja " << m_input.getDroppedCount();
+        std::cout << ")\n";
     }
 
-    if (m_lamp)
+    if (m_mailbox)
     {
-        m_lamp->color = lampColor;
-        m_lightPos = m_lamp->transform.position;
+        std::cout << "Render nit: nacrtan frejm " << rs.frameIndex << " (simulacija " << m_frameIndex
+            << "), preskoceno ukupno " << rs.framesDropped << "\n";
     }
-    m_lightColor = lampColor;
+}
 
-    m_shader->use();
-    m_shader->setVec3("u_LightPos", m_lightPos);
-    m_shader->setVec3("u_LightColor", m_lightColor);
-    m_shader->setVec3("u_AmbientColor", m_ambientColor);
-    m_shader->setFloat("u_AmbientStrength", m_ambientStrength);
-    m_shader->setVec3("u_ViewPos", m_camera->getPosition());
-    m_shader->setFloat("u_Shininess", 32.0f);
+void Application::updateLamps()
+{
+    // ===== LAMP = svetlo na sceni (aktivni automat) =====
+    // u koraku simulacije, pre Scene::update: promena boje je promena materijala u istom koraku
+    for (unsigned int i = 0; i < m_cabinets.size(); i++)
+    {
+        const Cabinet& cab = m_cabinets[i];
 
+        glm::vec3 lampColor{ 0.0f };
+        switch (cab.lampMode)
+        {
+        case LampMode::Off:
+            lampColor = { 1.0f, 1.0f, 1.0f };
+            break;
+        case LampMode::Blue:
+            lampColor = { 0.1f, 0.35f, 1.0f };
+            break;
+        case LampMode::WinBlink:
+            lampColor = cab.lampBlinkGreen ? glm::vec3(0.1f, 1.0f, 0.2f) : glm::vec3(1.0f, 0.15f, 0.15f);
+            break;
+        }
 
-    m_shader->use();
-    m_shader->setFloat("u_Alpha", 1.0f);
+        if (cab.lamp)
+            cab.lamp->color = lampColor;
+
+        if (i == m_activeCabinet)
+            m_lightColor = lampColor;
+    }
+}
+
+bool Application::needsRedraw(float alpha)
+{
+    // zahtev prozora (expose/resize) se uvek trosi, inace bi ostao za neki kasniji cist frejm
+    const bool refreshRequested = m_input.takeRedrawRequest();
+    if (m_idleFps <= 0.0f || m_scenario) return true;
+
+    // pomereni objekti se crtaju interpolirano: dok poslednji korak nesto pomera, slika zavisi od alpha
+    const bool interpolating = m_scene->getStats().sceneChanged;
+    const DrawnState& last = m_lastDrawn;
+
+    return !last.valid ||
+        m_scene->getChangeCount() != last.changeCount ||
+        (interpolating && alpha != last.alpha) ||
+        interpolating != last.interpolating ||
+        m_camera->getView() != last.view ||
+        m_lightColor != last.lightColor ||
+        m_depthEnabled != last.depthTest ||
+        m_cullEnabled != last.cullFace ||
+        m_scene->getRenderPath() != last.renderPath ||
+        m_scene->getOitEnabled() != last.oit ||
+        refreshRequested;
+}
+
+void Application::rememberDrawn(float alpha)
+{
+    DrawnState& last = m_lastDrawn;
+    last.valid = true;
+    last.changeCount = m_scene->getChangeCount();
+    last.alpha = alpha;
+    last.interpolating = m_scene->getStats().sceneChanged;
+    last.view = m_camera->getView();
+    last.lightColor = m_lightColor;
+    last.depthTest = m_depthEnabled;
+    last.cullFace = m_cullEnabled;
+    last.renderPath = m_scene->getRenderPath();
+    last.oit = m_scene->getOitEnabled();
+}
+
+void Application::buildFrame(FramePacket& packet, float alpha)
+{
+    const Cabinet& active = m_cabinets[m_activeCabinet];
+    if (active.lamp)
+        m_lightPos = glm::vec3(active.lamp->transform.getInterpolatedWorld(alpha)[3]);
 
+    packet.frameIndex = ++m_frameIndex;
+    packet.inputTime = m_input.takeOldestApplied();
 
-    m_scene->draw(*m_shader, *m_camera);
+    packet.view = m_camera->getView();
+    packet.projection = m_camera->getProjection();
+    packet.viewPos = m_camera->getPosition();
+
+    packet.lightPos = m_lightPos;
+    packet.lightColor = m_lightColor;
+    packet.ambientColor = m_ambientColor;
+    packet.ambientStrength = m_ambientStrength;
+
+    packet.depthTest = m_depthEnabled;
+    packet.cullFace = m_cullEnabled;
+
+    auto cullStart = Input::Clock::now();
+    m_scene->buildPacket(*m_camera, packet, alpha);
+    m_cullMs = std::chrono::duration<float, std::milli>(Input::Clock::now() - cullStart).count();
+}
+
+void Application::renderFrame(const FramePacket& packet)
+{
+    PROFILE_ZONE("render");
+
+    glClearColor(0.7f, 0.85f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    GLState::setEnabled(GL_DEPTH_TEST, packet.depthTest);
+    GLState::setEnabled(GL_CULL_FACE, packet.cullFace);
+    if (packet.cullFace) GLState::cullFace(GL_BACK);
+    GLState::disable(GL_BLEND);
+
+    m_renderer->draw(packet);
 
 
     // ===== DRAW WATERMARK =====
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::disable(GL_DEPTH_TEST);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     m_watermarkShader->use();
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_watermarkTexture);
+    GLState::bindTexture2D(0, m_watermarkTexture);
 
-    glBindVertexArray(m_watermarkVAO);
+    GLState::bindVertexArray(m_watermarkVAO);
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    glBindVertexArray(0);
 
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+    GLState::disable(GL_BLEND);
+    GLState::setEnabled(GL_DEPTH_TEST, packet.depthTest);
 
 }
 
 void Application::shutdown()
 {
+    delete m_renderer; m_renderer = nullptr;
     delete m_scene;   m_scene = nullptr;
     delete m_camera;  m_camera = nullptr;
     delete m_shader;  m_shader = nullptr;
+    delete m_instancedShader; m_instancedShader = nullptr;
+    delete m_oitShader; m_oitShader = nullptr;
+    delete m_bakedShader; m_bakedShader = nullptr;
+    delete m_oitPass; m_oitPass = nullptr;
 
     delete m_cubeMesh; m_cubeMesh = nullptr;
 
     delete m_sphereMesh; m_sphereMesh = nullptr;
 
+    m_cabinets.clear();
+    delete m_cabinetPrefab; m_cabinetPrefab = nullptr;
+
     delete m_watermarkShader;
     m_watermarkShader = nullptr;
 
-    if (m_watermarkVBO) glDeleteBuffers(1, &m_watermarkVBO);
-    if (m_watermarkVAO) glDeleteVertexArrays(1, &m_watermarkVAO);
+    if (m_watermarkVBO) { glDeleteBuffers(1, &m_watermarkVBO); GLState::onBufferDeleted(m_watermarkVBO); }
+    if (m_watermarkVAO) { glDeleteVertexArrays(1, &m_watermarkVAO); GLState::onVertexArrayDeleted(m_watermarkVAO); }
 
     if (m_coinCursor)  glfwDestroyCursor(m_coinCursor);
     if (m_leverCursor) glfwDestroyCursor(m_leverCursor);
@@ -1,12 +1,27 @@
 ﻿#pragma once
 #include "Window.h"
 #include <vector>
+#include <string>
 #include "GameObject.h"
+#include "Cabinet.h"
+#include "JobSystem.h"
+#include "FramePacket.h"
+#include "FrameStats.h"
+#include "FramePacer.h"
+#include "Input.h"
+#include "Scenario.h"
 #include <glm/glm.hpp>
+#include <memory>
+#include <mutex>
+#include <thread>
 class Shader;
 class Camera;
 class Mesh;
 class Scene;
+class OitPass;
+class Prefab;
+class SceneRenderer;
+class FrameMailbox;
 
 struct GLFWcursor;
 
@@ -17,31 +32,146 @@ public:
     Application();
     ~Application();
 
+    // broj automata na podu (--cabinets N); zadaje se pre run()
+    void setCabinetCount(unsigned int count) { m_cabinetCount = count > 0 ? count : 1; }
+
+    // fiksni korak igre i fizike (--sim-hz N), nezavisno od brzine crtanja
+    void setSimulationRate(unsigned int hz) { m_simulationHz = hz > 0 ? hz : 60; }
+
+    // ===== RITAM FREJMOVA =====
+    // hz = 0: bez ogranicenja; bez poziva 75, odnosno osvezavanje monitora uz vsync
+    void setFrameRate(float hz) { m_targetFps = hz; }
+    void setVSync(VSync mode) { m_vsync = mode; }
+    // ulaz kamere (i dogadjaji) se citaju posle simulacije, neposredno pre pravljenja paketa
+    void setLateLatching(bool enabled) { m_lateLatch = enabled; }
+
+    // GL na posebnoj niti (--render-thread [2|3]); buffers = 2 (Double) ili 3 (Triple) paketa
+    void setRenderThread(bool enabled, unsigned int buffers = 3) { m_renderThreadEnabled = enabled; m_renderBuffers = buffers; }
+
+    // --idle-fps N: frejm bez promena se ne crta; posle nekoliko takvih petlja spava na
+    // dogadjajima, a stanje proverava N puta u sekundi (0 = iskljuceno, crta se svaki frejm)
+    void setIdleRate(float hz) { m_idleFps = hz > 0.0f ? hz : 0.0f; }
+
+    // --headless WxH: offscreen kontekst i FBO zadate rezolucije, bez monitora
+    void setHeadless(int width, int height) { m_headless = true; m_headlessWidth = width; m_headlessHeight = height; }
+    // --frames N: posle N frejmova izlazi i ispisuje trajanje frejmova (0 = bez ogranicenja)
+    void setFrameLimit(unsigned int frames) { m_frameLimit = frames; }
+
+    // --scenario file --report out.json: ulaz iz skripte, jedan korak simulacije po frejmu,
+    // na kraju JSON sa vremenima faza i brojacima u reportPath
+    void setScenario(const std::string& path, const std::string& reportPath);
+
+    // --profile out.json: zone profajlera od pokretanja, Chrome trace na izlazu i na F5
+    void setProfileOutput(const std::string& path) { m_profilePath = path; }
+
     void run();
 
 private:
     void init();
+    // instancira prefab automata count puta (automat 0 je igracev)
+    void spawnCabinets(unsigned int count);
     void update(float dt);
-    void render();
     void shutdown();
 
+    // simulacija: lampe, svetlo i kamera + Scene::buildPacket (bez GL poziva);
+    // alpha = udeo sledeceg koraka koji je vec protekao (interpolacija transforma)
+    void buildFrame(FramePacket& packet, float alpha);
+    // pravljenje paketa + crtanje (ili predaja render niti)
+    void drawFrame(float alpha);
+    // boje lampi i boja svetla; u koraku simulacije
+    void updateLamps();
+
+    // ===== IDLE =====
+    // true ako bi slika bila drugacija od poslednje nacrtane
+    bool needsRedraw(float alpha);
+    void rememberDrawn(float alpha);
+    // GL: brisanje, scena, watermark; samo na niti koja drzi kontekst
+    void renderFrame(const FramePacket& packet);
+
+    // ===== RENDER NIT =====
+    // glavna nit otpusta kontekst, render nit ga preuzima i crta pakete iz m_mailbox-a
+    void startRenderThread();
+    void stopRenderThread();
+    void renderThreadLoop();
+    // posle swapBuffers; meri i kasnjenje ulaz -> ekran za dogadjaje iz paketa
+    void publishRenderStats(const FramePacket& packet, float submitMs);
+    RenderStats getRenderStats() const;
+
 private:
     bool m_running = true;
     Window m_window;
 
     Shader* m_shader = nullptr;
+    Shader* m_instancedShader = nullptr;
+    Shader* m_oitShader = nullptr;
+    Shader* m_bakedShader = nullptr;
+    OitPass* m_oitPass = nullptr;
     Camera* m_camera = nullptr;
     Scene* m_scene = nullptr;
+    SceneRenderer* m_renderer = nullptr;
+
+    FramePacer m_pacer;
+    float m_targetFps = -1.0f;              // < 0: podrazumevano
+    VSync m_vsync = VSync::Off;
+    bool m_lateLatch = false;
+
+    unsigned int m_simulationHz = 60;
+    unsigned int m_simulationSteps = 0;     // koraka u poslednjem frejmu
+
+    bool m_renderThreadEnabled = false;
+    unsigned int m_renderBuffers = 3;
+    std::unique_ptr<FrameMailbox> m_mailbox;
+    std::thread m_renderThread;
+    FramePacket m_packet;                   // bez render niti: jedan paket, crta se odmah
+    unsigned int m_frameIndex = 0;
+
+    // stanje od kog zavisi poslednja nacrtana slika
+    struct DrawnState
+    {
+        bool valid = false;
+        unsigned int changeCount = 0;
+        float alpha = 0.0f;
+        bool interpolating = false;
+        glm::mat4 view{ 1.0f };
+        glm::vec3 lightColor{ 0.0f };
+        bool depthTest = true;
+        bool cullFace = false;
+        RenderPath renderPath = RenderPath::Classic;
+        bool oit = false;
+    };
+
+    static const unsigned int kIdleAfterFrames = 3;     // uzastopnih frejmova bez promene
+    float m_idleFps = 0.0f;
+    bool m_idle = false;
+    unsigned int m_cleanFrames = 0;
+    unsigned int m_framesSkipped = 0;       // ukupno od pokretanja
+    DrawnState m_lastDrawn;
+
+    bool m_headless = false;
+    int m_headlessWidth = 1280;
+    int m_headlessHeight = 720;
+    unsigned int m_frameLimit = 0;
+    std::vector<float> m_frameTimes;        // ms, za --frames
+
+    std::string m_scenarioPath;
+    std::string m_scenarioReport;
+    std::unique_ptr<Scenario> m_scenario;
+    unsigned int m_scenarioFrame = 0;
+    std::vector<ScenarioSample> m_scenarioSamples;
+    float m_cullMs = 0.0f;                  // Scene::buildPacket poslednjeg frejma
+
+    std::string m_profilePath;
 
     Mesh* m_cubeMesh = nullptr;
 
     Mesh* m_sphereMesh = nullptr;
-    GameObject* m_lamp = nullptr;
 
-    enum class LampMode { Off, Blue, WinBlink };
-    LampMode m_lampMode = LampMode::Off;
-    float m_lampBlinkTimer = 0.0f;
-    bool m_lampBlinkGreen = true;
+    // ===== AUTOMATI =====
+    // zajednicki (nepromenljivi) opis automata + po instanci samo stanje igre
+    Prefab* m_cabinetPrefab = nullptr;
+    std::vector<Cabinet> m_cabinets;
+    unsigned int m_cabinetCount = 1;
+    unsigned int m_activeCabinet = 0;     // automat kojim igrac upravlja
 
     glm::vec3 m_lightPos{ 0.0f, 3.0f, 0.0f };
     glm::vec3 m_lightColor{ 0.0f, 0.0f, 0.0f };
@@ -49,11 +179,8 @@ private:
     glm::vec3 m_ambientColor{ 1.0f, 1.0f, 1.0f };
     float m_ambientStrength = 0.20f;
 
-    GameObject* m_clawRoot = nullptr;
     float m_clawSpeed = 2.0f;
     float m_dropSpeed = 2.0f;
-    bool m_dropping = false;
-    bool m_returning = false;
 
     Shader* m_watermarkShader = nullptr;
 
@@ -62,37 +189,24 @@ private:
     unsigned int m_watermarkTexture = 0;
 
     bool m_closeView = false;
-    bool m_mousePressed = false;
+
+    // dogadjaji iz GLFW callback-a; update() cita stanje tekuceg koraka simulacije
+    Input m_input;
 
 
     bool m_depthEnabled = true;
     bool m_cullEnabled = false;
-    bool m_dPressed = false;
-    bool m_cPressed = false;
+
+    // GL strana poslednjeg nacrtanog frejma (draw pozivi, GLState); pise je render nit
+    mutable std::mutex m_renderStatsMutex;
+    RenderStats m_renderStats;
+    TransformSystem::Counters m_transformCounters;   // prethodni frejm
+    std::vector<JobSystem::WorkerStats> m_jobStats;  // prethodni frejm, po niti
+    float m_jobStatsMs = 0.0f;
 
     GLFWcursor* m_coinCursor = nullptr;
     GLFWcursor* m_leverCursor = nullptr;
 
-    bool m_machineOn = false;   // stanje automata
-
-    // ===== GAME STATE =====
-    enum class GameState { Off, Playing, Dropping, Returning, Carrying, ToyFalling, PrizeBlink };
-    GameState m_state = GameState::Off;
-
-    GameObject* m_coinSlotObj = nullptr;
-
-    GameObject* m_teddyObj = nullptr;
-    GameObject* m_sheepObj = nullptr;
-
-    std::vector<GameObject*> m_toys;
-    std::vector<GameObject*> m_fingers;
-
-    GameObject* m_grabbedToy = nullptr;   // trenutno u kandži
-    GameObject* m_prizeToy = nullptr;     // osvojena 
-
-    glm::vec3 m_toyVelocity{ 0.0f };
-    bool m_spaceDown = false;
-    bool m_lmbDown = false;
 
     // ===== TUNING =====
     float m_clawStartY = 2.5f;
@@ -114,9 +228,11 @@ private:
     glm::vec3 m_prizePos{ 0.0f, -2.2f, 2.2f };    // gde se vidi osvojena igračka 
 
 
-    void setClawOpen(bool open);
+    void setClawOpen(Cabinet& cab, bool open);
     void updateCursor();
-    bool m_clawOpen = true;
+    void printFrameStats() const;
+    void printBenchmarkReport(float seconds) const;
+    void recordScenarioFrame(float frameMs, float updateMs);
 
     glm::vec3 m_grabOffset{ 0.0f, -2.2f, 0.0f };
 
@@ -0,0 +1,97 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cfloat>
+
+struct Aabb
+{
+    glm::vec3 min{ FLT_MAX };
+    glm::vec3 max{ -FLT_MAX };
+
+    bool valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    void expand(const glm::vec3& p)
+    {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+
+    void expand(const Aabb& b)
+    {
+        min = glm::min(min, b.min);
+        max = glm::max(max, b.max);
+    }
+
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    glm::vec3 extents() const { return (max - min) * 0.5f; }
+
+    float surfaceArea() const
+    {
+        if (!valid()) return 0.0f;
+        glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    bool overlapsSphere(const glm::vec3& c, float r) const
+    {
+        glm::vec3 closest = glm::clamp(c, min, max);
+        glm::vec3 d = closest - c;
+        return glm::dot(d, d) <= r * r;
+    }
+
+    // slab test; invDir = 1/dir. Vraca ulaznu udaljenost u tEnter.
+    bool intersectsRay(const glm::vec3& origin, const glm::vec3& invDir, float maxT, float& tEnter) const
+    {
+        glm::vec3 t0 = (min - origin) * invDir;
+        glm::vec3 t1 = (max - origin) * invDir;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+
+        float enter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.0f));
+        float exit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, maxT));
+
+        tEnter = enter;
+        return enter <= exit;
+    }
+};
+
+struct BoundingSphere
+{
+    glm::vec3 center{ 0.0f };
+    float radius = -1.0f;   // < 0 = nema granica (objekat bez mesh-a)
+
+    bool valid() const { return radius >= 0.0f; }
+};
+
+// sfera koja obuhvata lokalni AABB posle primene (afine) model matrice
+inline BoundingSphere transformBounds(const Aabb& local, const glm::mat4& model)
+{
+    BoundingSphere s;
+    if (!local.valid()) return s;
+
+    s.center = glm::vec3(model * glm::vec4(local.center(), 1.0f));
+
+    float sx = glm::dot(glm::vec3(model[0]), glm::vec3(model[0]));
+    float sy = glm::dot(glm::vec3(model[1]), glm::vec3(model[1]));
+    float sz = glm::dot(glm::vec3(model[2]), glm::vec3(model[2]));
+    float maxScale = glm::sqrt(glm::max(sx, glm::max(sy, sz)));
+
+    s.radius = glm::length(local.extents()) * maxScale;
+    return s;
+}
+
+// svetski AABB lokalnog AABB-a (Arvo: centar + apsolutna matrica puta extents)
+inline Aabb transformAabb(const Aabb& local, const glm::mat4& model)
+{
+    Aabb out;
+    if (!local.valid()) return out;
+
+    glm::vec3 c = glm::vec3(model * glm::vec4(local.center(), 1.0f));
+    glm::vec3 e = local.extents();
+
+    glm::mat3 absM(glm::abs(glm::vec3(model[0])), glm::abs(glm::vec3(model[1])), glm::abs(glm::vec3(model[2])));
+    glm::vec3 we = absM * e;
+
+    out.min = c - we;
+    out.max = c + we;
+    return out;
+}
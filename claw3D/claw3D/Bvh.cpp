@@ -0,0 +1,396 @@
+#include "Bvh.h"
+#include "Frustum.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace
+{
+    const unsigned int kMaxLeafItems = 4;
+    const int kBinCount = 12;
+}
+
+void Bvh::clear()
+{
+    m_nodes.clear();
+    m_items.clear();
+    m_boxes.clear();
+    m_sx.clear(); m_sy.clear(); m_sz.clear(); m_sr.clear();
+    m_garbageNodes = 0;
+}
+
+void Bvh::build(const Aabb* boxes, const BoundingSphere* spheres, unsigned int count)
+{
+    clear();
+    if (count == 0) return;
+
+    m_items.resize(count);
+    m_boxes.assign(boxes, boxes + count);
+    m_sx.resize(count); m_sy.resize(count); m_sz.resize(count); m_sr.resize(count);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        m_items[i] = i;
+        m_sx[i] = spheres[i].center.x;
+        m_sy[i] = spheres[i].center.y;
+        m_sz[i] = spheres[i].center.z;
+        m_sr[i] = spheres[i].radius;
+    }
+
+    m_nodes.reserve(count * 2);
+    m_nodes.push_back(Node());
+    buildNode(0, 0, count);
+}
+
+void Bvh::buildNode(int nodeIndex, unsigned int first, unsigned int count)
+{
+    Aabb bounds;
+    Aabb centroids;
+    for (unsigned int i = first; i < first + count; i++)
+    {
+        bounds.expand(m_boxes[i]);
+        centroids.expand(m_boxes[i].center());
+    }
+
+    {
+        Node& node = m_nodes[nodeIndex];
+        node.bounds = bounds;
+        node.buildArea = bounds.surfaceArea();
+        node.first = first;
+        node.count = count;
+        node.left = node.right = -1;
+    }
+
+    if (count <= kMaxLeafItems) return;
+
+    // ===== BINNED SAH PO NAJDUZOJ OSI CENTROIDA =====
+    glm::vec3 extent = centroids.max - centroids.min;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    unsigned int mid = first + count / 2;
+    float leafCost = bounds.surfaceArea() * (float)count;
+
+    if (extent[axis] > 1e-6f)
+    {
+        struct Bin { Aabb bounds; unsigned int count = 0; };
+        Bin bins[kBinCount];
+
+        const float scale = (float)kBinCount / extent[axis];
+        auto binOf = [&](unsigned int slot)
+            {
+                int b = (int)((m_boxes[slot].center()[axis] - centroids.min[axis]) * scale);
+                return std::min(b, kBinCount - 1);
+            };
+
+        for (unsigned int i = first; i < first + count; i++)
+        {
+            Bin& bin = bins[binOf(i)];
+            bin.bounds.expand(m_boxes[i]);
+            bin.count++;
+        }
+
+        // cena podele posle bin-a s: A(levo)*N(levo) + A(desno)*N(desno)
+        float rightArea[kBinCount];
+        unsigned int rightCount[kBinCount];
+        Aabb acc;
+        unsigned int accCount = 0;
+        for (int b = kBinCount - 1; b > 0; b--)
+        {
+            acc.expand(bins[b].bounds);
+            accCount += bins[b].count;
+            rightArea[b] = acc.surfaceArea();
+            rightCount[b] = accCount;
+        }
+
+        float bestCost = FLT_MAX;
+        int bestSplit = -1;
+        acc = Aabb();
+        accCount = 0;
+        for (int b = 0; b < kBinCount - 1; b++)
+        {
+            acc.expand(bins[b].bounds);
+            accCount += bins[b].count;
+            if (accCount == 0 || rightCount[b + 1] == 0) continue;
+
+            float cost = acc.surfaceArea() * (float)accCount + rightArea[b + 1] * (float)rightCount[b + 1];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+
+        if (bestSplit >= 0 && bestCost < leafCost)
+        {
+            // particija slotova (zajedno sa kopijama granica)
+            unsigned int i = first;
+            unsigned int j = first + count;
+            while (i < j)
+            {
+                if (binOf(i) <= bestSplit)
+                {
+                    i++;
+                }
+                else
+                {
+                    j--;
+                    std::swap(m_items[i], m_items[j]);
+                    std::swap(m_boxes[i], m_boxes[j]);
+                    std::swap(m_sx[i], m_sx[j]);
+                    std::swap(m_sy[i], m_sy[j]);
+                    std::swap(m_sz[i], m_sz[j]);
+                    std::swap(m_sr[i], m_sr[j]);
+                }
+            }
+            if (i > first && i < first + count)
+                mid = i;
+        }
+    }
+
+    // deca se uvek dodaju na kraj -> indeks deteta > indeks roditelja (refit ide unazad)
+    int left = (int)m_nodes.size();
+    m_nodes.push_back(Node());
+    int right = (int)m_nodes.size();
+    m_nodes.push_back(Node());
+
+    m_nodes[nodeIndex].left = left;
+    m_nodes[nodeIndex].right = right;
+
+    buildNode(left, first, mid - first);
+    buildNode(right, mid, first + count - mid);
+}
+
+void Bvh::refit(const Aabb* boxes, const BoundingSphere* spheres)
+{
+    for (size_t slot = 0; slot < m_items.size(); slot++)
+    {
+        unsigned int item = m_items[slot];
+        m_boxes[slot] = boxes[item];
+        m_sx[slot] = spheres[item].center.x;
+        m_sy[slot] = spheres[item].center.y;
+        m_sz[slot] = spheres[item].center.z;
+        m_sr[slot] = spheres[item].radius;
+    }
+
+    for (int n = (int)m_nodes.size() - 1; n >= 0; n--)
+    {
+        Node& node = m_nodes[n];
+        Aabb b;
+        if (node.isLeaf())
+        {
+            for (unsigned int i = node.first; i < node.first + node.count; i++)
+                b.expand(m_boxes[i]);
+        }
+        else
+        {
+            b = m_nodes[node.left].bounds;
+            b.expand(m_nodes[node.right].bounds);
+        }
+        node.bounds = b;
+    }
+}
+
+unsigned int Bvh::countSubtree(int nodeIndex) const
+{
+    const Node& node = m_nodes[nodeIndex];
+    if (node.isLeaf()) return 1;
+    return 1 + countSubtree(node.left) + countSubtree(node.right);
+}
+
+unsigned int Bvh::rebuildDegraded(float maxGrowth)
+{
+    if (m_nodes.empty()) return 0;
+
+    // previse napustenih cvorova -> kompletna izgradnja
+    if (m_garbageNodes > m_nodes.size() / 2)
+    {
+        unsigned int count = (unsigned int)m_items.size();
+        m_nodes.clear();
+        m_garbageNodes = 0;
+        m_nodes.push_back(Node());
+        buildNode(0, 0, count);
+        return 1;
+    }
+
+    unsigned int rebuilt = 0;
+    std::vector<int> stack;
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        int n = stack.back();
+        stack.pop_back();
+
+        const Node& node = m_nodes[n];
+        if (node.isLeaf()) continue;
+
+        if (node.bounds.surfaceArea() > node.buildArea * maxGrowth)
+        {
+            unsigned int old = countSubtree(n) - 1;
+
+            // stari potomci postaju prazni listovi (refit ih preskace bez efekta)
+            std::vector<int> dead;
+            dead.push_back(node.left);
+            dead.push_back(node.right);
+            while (!dead.empty())
+            {
+                Node& d = m_nodes[dead.back()];
+                dead.pop_back();
+                if (!d.isLeaf())
+                {
+                    dead.push_back(d.left);
+                    dead.push_back(d.right);
+                }
+                d.left = d.right = -1;
+                d.count = 0;
+                d.bounds = Aabb();
+            }
+
+            m_garbageNodes += old;
+            buildNode(n, node.first, node.count);
+            rebuilt++;
+            continue;
+        }
+
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+    }
+
+    return rebuilt;
+}
+
+void Bvh::addLeafItems(const Node& node, std::vector<unsigned int>& out) const
+{
+    for (unsigned int i = node.first; i < node.first + node.count; i++)
+        out.push_back(m_items[i]);
+}
+
+void Bvh::queryFrustum(const Frustum& frustum, std::vector<unsigned int>& out) const
+{
+    if (m_nodes.empty()) return;
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& node = m_nodes[stack[--top]];
+
+        Frustum::Result r = frustum.classify(node.bounds);
+        if (r == Frustum::Result::Outside) continue;
+
+        if (r == Frustum::Result::Inside)
+        {
+            addLeafItems(node, out);
+            continue;
+        }
+
+        if (node.isLeaf())
+        {
+            // delimicno presecen list: sfere elemenata SIMD testom
+            unsigned char visible[kMaxLeafItems];
+            frustum.cullSpheres(&m_sx[node.first], &m_sy[node.first], &m_sz[node.first], &m_sr[node.first],
+                node.count, visible);
+
+            for (unsigned int i = 0; i < node.count; i++)
+            {
+                if (visible[i]) out.push_back(m_items[node.first + i]);
+            }
+            continue;
+        }
+
+        if (top + 2 > 64)
+        {
+            addLeafItems(node, out);
+            continue;
+        }
+        stack[top++] = node.left;
+        stack[top++] = node.right;
+    }
+}
+
+void Bvh::querySphere(const glm::vec3& center, float radius, std::vector<unsigned int>& out) const
+{
+    if (m_nodes.empty()) return;
+
+    std::vector<int> stack;
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+
+        if (!node.bounds.overlapsSphere(center, radius)) continue;
+
+        if (node.isLeaf())
+        {
+            for (unsigned int i = node.first; i < node.first + node.count; i++)
+            {
+                if (m_boxes[i].overlapsSphere(center, radius))
+                    out.push_back(m_items[i]);
+            }
+            continue;
+        }
+
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+    }
+}
+
+int Bvh::raycast(const glm::vec3& origin, const glm::vec3& dir, float maxT, float& tHit) const
+{
+    if (m_nodes.empty()) return -1;
+
+    glm::vec3 invDir(
+        dir.x != 0.0f ? 1.0f / dir.x : FLT_MAX,
+        dir.y != 0.0f ? 1.0f / dir.y : FLT_MAX,
+        dir.z != 0.0f ? 1.0f / dir.z : FLT_MAX);
+
+    int best = -1;
+    float bestT = maxT;
+
+    std::vector<int> stack;
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+
+        float tEnter;
+        if (!node.bounds.intersectsRay(origin, invDir, bestT, tEnter)) continue;
+
+        if (node.isLeaf())
+        {
+            for (unsigned int i = node.first; i < node.first + node.count; i++)
+            {
+                float t;
+                if (m_boxes[i].intersectsRay(origin, invDir, bestT, t) && t < bestT)
+                {
+                    bestT = t;
+                    best = (int)m_items[i];
+                }
+            }
+            continue;
+        }
+
+        // blize dete se obradjuje prvo (ide poslednje na stek)
+        float tl = FLT_MAX, tr = FLT_MAX;
+        bool hl = m_nodes[node.left].bounds.intersectsRay(origin, invDir, bestT, tl);
+        bool hr = m_nodes[node.right].bounds.intersectsRay(origin, invDir, bestT, tr);
+        if (hl && hr)
+        {
+            if (tl < tr) { stack.push_back(node.right); stack.push_back(node.left); }
+            else         { stack.push_back(node.left);  stack.push_back(node.right); }
+        }
+        else if (hl) stack.push_back(node.left);
+        else if (hr) stack.push_back(node.right);
+    }
+
+    tHit = bestT;
+    return best;
+}
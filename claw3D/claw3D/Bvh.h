@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+class Frustum;
+
+// Dinamicki BVH nad svetskim granicama objekata.
+// Elementi se identifikuju indeksom u nizove koje prosledjuje vlasnik (Scene).
+// build = SAH (binned), refit = osvezavanje granica odozdo, rebuildDegraded = ponovna izgradnja
+// samo onih podstabala cija je povrsina previse porasla od poslednje izgradnje.
+class Bvh
+{
+public:
+    void build(const Aabb* boxes, const BoundingSphere* spheres, unsigned int count);
+    void refit(const Aabb* boxes, const BoundingSphere* spheres);
+
+    // vraca broj ponovo izgradjenih podstabala
+    unsigned int rebuildDegraded(float maxGrowth = 1.5f);
+
+    void clear();
+
+    // indeksi elemenata koji su (bar delimicno) u frustumu
+    void queryFrustum(const Frustum& frustum, std::vector<unsigned int>& out) const;
+
+    // elementi ciji AABB sece sferu
+    void querySphere(const glm::vec3& center, float radius, std::vector<unsigned int>& out) const;
+
+    // najblizi element ciji AABB sece zrak; -1 ako nema pogotka
+    int raycast(const glm::vec3& origin, const glm::vec3& dir, float maxT, float& tHit) const;
+
+    unsigned int getItemCount() const { return (unsigned int)m_items.size(); }
+    unsigned int getNodeCount() const { return (unsigned int)m_nodes.size() - m_garbageNodes; }
+
+private:
+    struct Node
+    {
+        Aabb bounds;
+        float buildArea = 0.0f;
+        int left = -1;              // -1 = list
+        int right = -1;
+        unsigned int first = 0;     // opseg elemenata podstabla u m_items
+        unsigned int count = 0;
+
+        bool isLeaf() const { return left < 0; }
+    };
+
+    void buildNode(int nodeIndex, unsigned int first, unsigned int count);
+    unsigned int countSubtree(int nodeIndex) const;
+    void addLeafItems(const Node& node, std::vector<unsigned int>& out) const;
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<unsigned int> m_items;  // permutacija indeksa elemenata
+
+    // kopije granica u redosledu m_items (listovi se testiraju SIMD-om nad SoA)
+    std::vector<Aabb> m_boxes;
+    std::vector<float> m_sx, m_sy, m_sz, m_sr;
+
+    unsigned int m_garbageNodes = 0;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "SmallVector.h"
+
+class GameObject;
+
+enum class GameState { Off, Playing, Dropping, Returning, Carrying, ToyFalling, PrizeBlink };
+enum class LampMode { Off, Blue, WinBlink };
+
+// Jedan automat na podu arkade. Hijerarhija, mesh-evi, materijali i teksture su u zajednickom
+// Prefab-u; instanca nosi samo stanje igre i pokazivace na svoje objekte koje igra pomera.
+// Sve pozicije u igri su u lokalnom prostoru automata (deca root-a).
+struct Cabinet
+{
+    GameObject* root = nullptr;         // prazan cvor sa transformom instance
+    GameObject* clawRoot = nullptr;
+    GameObject* lamp = nullptr;
+    GameObject* coinSlot = nullptr;
+    SmallVector<GameObject*, 4> fingers;
+    SmallVector<GameObject*, 4> toys;
+
+    GameState state = GameState::Off;
+    LampMode lampMode = LampMode::Off;
+    float lampBlinkTimer = 0.0f;
+    bool lampBlinkGreen = true;
+    bool machineOn = false;
+    bool clawOpen = true;
+    bool dropping = false;
+    bool returning = false;
+
+    GameObject* grabbedToy = nullptr;   // trenutno u kandzi
+    GameObject* prizeToy = nullptr;     // osvojena
+    glm::vec3 toyVelocity{ 0.0f };
+};
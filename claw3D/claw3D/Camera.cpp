@@ -1,4 +1,6 @@
 ﻿#include "Camera.h"
+#include "Input.h"
+#include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
 
 Camera::Camera(float fov, float aspect, float nearP, float farP)
@@ -6,14 +8,14 @@ Camera::Camera(float fov, float aspect, float nearP, float farP)
 {
 }
 
-void Camera::processInput(GLFWwindow* window, float dt)
+void Camera::processInput(const Input& input, float dt)
 {
     float speed = 60.0f * dt;
 
-    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
+    if (input.isDownNow(GLFW_KEY_LEFT))
         m_yaw -= speed;
 
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
+    if (input.isDownNow(GLFW_KEY_RIGHT))
         m_yaw += speed;
 
     if (m_yaw > 90.0f)  m_yaw = 90.0f;
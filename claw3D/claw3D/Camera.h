@@ -1,14 +1,16 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <GLFW/glfw3.h>
+
+class Input;
 
 class Camera
 {
 public:
     Camera(float fov, float aspect, float nearP, float farP);
 
-    void processInput(GLFWwindow* window, float dt);
+    // strelice levo/desno; jednom po frejmu (ne u koraku simulacije), sa najsvezijim stanjem
+    void processInput(const Input& input, float dt);
 
     glm::mat4 getView() const;
     glm::mat4 getProjection() const;
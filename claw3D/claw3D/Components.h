@@ -0,0 +1,45 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+class Mesh;
+class GameObject;
+
+// ECS komponente scene (POD, zive u kolonama archetype-ova, vidi Ecs.h)
+
+// rucka na cvor u TransformSystem-u (same matrice su vec u SoA nizovima tamo)
+struct TransformComponent
+{
+    unsigned int transformId;
+};
+
+struct RenderComponent
+{
+    Mesh* mesh;
+    glm::vec3 color;
+    unsigned int texture;
+    bool useTexture;
+    bool transparent;
+    bool occluder;
+    bool isStatic;
+};
+
+// svetske granice; racunaju se samo kad se promeni verzija svetske matrice
+struct BoundsComponent
+{
+    Aabb aabb;
+    BoundingSphere sphere;
+    unsigned int transformVersion;
+    bool valid;
+};
+
+// neaktivni entiteti (GameObject::active == false); upiti ih iskljucuju maskom
+struct InactiveTag
+{
+};
+
+// privremena veza ka GameObject-u dok traje migracija (Scene::createObject)
+struct LegacyObject
+{
+    GameObject* object;
+};
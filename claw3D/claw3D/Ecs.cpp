@@ -0,0 +1,152 @@
+#include "Ecs.h"
+
+unsigned int ecs_detail::nextComponentId()
+{
+    static unsigned int next = 0;
+    return next++;
+}
+
+EcsWorld::EcsWorld()
+{
+    // archetype 0 = entitet bez komponenti
+    getOrCreateArchetype(0);
+}
+
+Entity EcsWorld::create()
+{
+    unsigned int index;
+    if (!m_freeIndices.empty())
+    {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    }
+    else
+    {
+        index = (unsigned int)m_records.size();
+        m_records.push_back(Record());
+    }
+
+    Record& rec = m_records[index];
+    rec.alive = true;
+    rec.archetype = 0;
+
+    Entity e;
+    e.index = index;
+    e.generation = rec.generation;
+
+    Archetype& empty = *m_archetypes[0];
+    rec.row = empty.size();
+    empty.m_entities.push_back(e);
+
+    m_aliveCount++;
+    return e;
+}
+
+void EcsWorld::clear()
+{
+    // generacije se cuvaju da stari id-jevi ne bi ozivali posle ponovne upotrebe slota
+    m_freeIndices.clear();
+    for (unsigned int i = (unsigned int)m_records.size(); i-- > 0;)
+    {
+        Record& rec = m_records[i];
+        if (rec.alive)
+        {
+            rec.alive = false;
+            rec.generation++;
+        }
+        m_freeIndices.push_back(i);
+    }
+    m_aliveCount = 0;
+
+    m_archetypes.clear();
+    m_archetypeByMask.clear();
+    getOrCreateArchetype(0);
+}
+
+bool EcsWorld::isAlive(Entity e) const
+{
+    return e.index < m_records.size() && m_records[e.index].alive &&
+        m_records[e.index].generation == e.generation;
+}
+
+void EcsWorld::destroy(Entity e)
+{
+    if (!isAlive(e)) return;
+
+    Record& rec = m_records[e.index];
+    removeRow(rec.archetype, rec.row);
+
+    rec.alive = false;
+    rec.generation++;
+    m_freeIndices.push_back(e.index);
+    m_aliveCount--;
+}
+
+unsigned int EcsWorld::getOrCreateArchetype(ComponentMask mask)
+{
+    auto it = m_archetypeByMask.find(mask);
+    if (it != m_archetypeByMask.end()) return it->second;
+
+    std::unique_ptr<Archetype> arch(new Archetype(mask));
+    for (unsigned int type = 0; type < 32; type++)
+    {
+        if (mask & (1u << type))
+            arch->m_columns.push_back({ type, m_componentSizes[type], {} });
+    }
+
+    const unsigned int index = (unsigned int)m_archetypes.size();
+    m_archetypes.push_back(std::move(arch));
+    m_archetypeByMask[mask] = index;
+    return index;
+}
+
+void EcsWorld::moveEntity(Entity e, unsigned int target)
+{
+    Record& rec = m_records[e.index];
+    Archetype& src = *m_archetypes[rec.archetype];
+    Archetype& dst = *m_archetypes[target];
+
+    const unsigned int newRow = dst.size();
+    dst.m_entities.push_back(e);
+
+    // zajednicke komponente se kopiraju, nove su nulirane (add ih odmah upisuje)
+    for (Archetype::Column& col : dst.m_columns)
+    {
+        col.data.resize(col.data.size() + col.elementSize, 0);
+
+        Archetype::Column* old = src.findColumn(col.type);
+        if (old)
+        {
+            std::memcpy(&col.data[(size_t)newRow * col.elementSize],
+                &old->data[(size_t)rec.row * col.elementSize], col.elementSize);
+        }
+    }
+
+    removeRow(rec.archetype, rec.row);
+
+    rec.archetype = target;
+    rec.row = newRow;
+}
+
+void EcsWorld::removeRow(unsigned int archetype, unsigned int row)
+{
+    Archetype& arch = *m_archetypes[archetype];
+    const unsigned int last = arch.size() - 1;
+
+    // poslednji red se premesta na mesto uklonjenog (nizovi ostaju gusti)
+    if (row != last)
+    {
+        const Entity moved = arch.m_entities[last];
+        arch.m_entities[row] = moved;
+        for (Archetype::Column& col : arch.m_columns)
+        {
+            std::memcpy(&col.data[(size_t)row * col.elementSize],
+                &col.data[(size_t)last * col.elementSize], col.elementSize);
+        }
+        m_records[moved.index].row = row;
+    }
+
+    arch.m_entities.pop_back();
+    for (Archetype::Column& col : arch.m_columns)
+        col.data.resize(col.data.size() - col.elementSize);
+}
@@ -0,0 +1,204 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+
+// Archetype ECS: entiteti sa istim skupom komponenti dele archetype, a svaka komponenta
+// archetype-a je gust niz (kolona). Upit prolazi samo kroz archetype-ove koji imaju sve
+// trazene komponente, red po red kroz kontinualnu memoriju.
+// Komponente su POD (kopiraju se memcpy-jem pri prelasku u drugi archetype).
+
+struct Entity
+{
+    unsigned int index = ~0u;
+    unsigned int generation = 0;    // raste pri svakom unistavanju slota -> stari id-jevi postaju nevazeci
+
+    bool isNull() const { return index == ~0u; }
+    bool operator==(const Entity& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const Entity& o) const { return !(*this == o); }
+};
+
+typedef unsigned int ComponentMask;    // najvise 32 tipa komponenti
+
+namespace ecs_detail
+{
+    unsigned int nextComponentId();
+}
+
+template <typename T>
+unsigned int componentId()
+{
+    static const unsigned int id = ecs_detail::nextComponentId();
+    return id;
+}
+
+template <typename... Ts>
+ComponentMask componentMask()
+{
+    ComponentMask mask = 0;
+    int expand[] = { 0, (mask |= 1u << componentId<Ts>(), 0)... };
+    (void)expand;
+    return mask;
+}
+
+class Archetype
+{
+public:
+    explicit Archetype(ComponentMask mask) : m_mask(mask) {}
+
+    ComponentMask getMask() const { return m_mask; }
+    unsigned int size() const { return (unsigned int)m_entities.size(); }
+    const Entity* getEntities() const { return m_entities.data(); }
+
+    template <typename T>
+    T* column()
+    {
+        Column* c = findColumn(componentId<T>());
+        return c ? reinterpret_cast<T*>(c->data.data()) : nullptr;
+    }
+
+private:
+    friend class EcsWorld;
+
+    struct Column
+    {
+        unsigned int type;
+        size_t elementSize;
+        std::vector<unsigned char> data;
+    };
+
+    Column* findColumn(unsigned int type)
+    {
+        for (Column& c : m_columns)
+        {
+            if (c.type == type) return &c;
+        }
+        return nullptr;
+    }
+
+private:
+    ComponentMask m_mask;
+    std::vector<Entity> m_entities;
+    std::vector<Column> m_columns;
+};
+
+class EcsWorld
+{
+public:
+    EcsWorld();
+
+    Entity create();
+    void destroy(Entity e);
+    bool isAlive(Entity e) const;
+
+    // brise sve entitete i archetype-ove (stari Entity id-jevi postaju nevazeci)
+    void clear();
+
+    template <typename T>
+    T& add(Entity e, const T& value = T())
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "ECS komponente moraju biti POD");
+        const unsigned int type = registerComponent<T>();
+
+        // zastarela rucka (posle destroy/clear): upis ide u odbacenu kopiju, a ne u red
+        // archetype-a koji sada pripada drugom entitetu
+        if (!isAlive(e))
+        {
+            static T s_discarded;
+            s_discarded = value;
+            return s_discarded;
+        }
+
+        Record& rec = m_records[e.index];
+        if (!(m_archetypes[rec.archetype]->m_mask & (1u << type)))
+            moveEntity(e, getOrCreateArchetype(m_archetypes[rec.archetype]->m_mask | (1u << type)));
+
+        T* slot = m_archetypes[rec.archetype]->column<T>() + rec.row;
+        *slot = value;
+        return *slot;
+    }
+
+    template <typename T>
+    void remove(Entity e)
+    {
+        if (!isAlive(e)) return;
+
+        const unsigned int type = componentId<T>();
+        const Record& rec = m_records[e.index];
+        if (m_archetypes[rec.archetype]->m_mask & (1u << type))
+            moveEntity(e, getOrCreateArchetype(m_archetypes[rec.archetype]->m_mask & ~(1u << type)));
+    }
+
+    template <typename T>
+    bool has(Entity e) const
+    {
+        if (!isAlive(e)) return false;
+        return (m_archetypes[m_records[e.index].archetype]->m_mask & (1u << componentId<T>())) != 0;
+    }
+
+    // nullptr ako entitet nije ziv ili nema komponentu; pokazivac vazi do sledece strukturne promene
+    template <typename T>
+    T* get(Entity e)
+    {
+        if (!isAlive(e)) return nullptr;
+        const Record& rec = m_records[e.index];
+        T* col = m_archetypes[rec.archetype]->column<T>();
+        return col ? col + rec.row : nullptr;
+    }
+
+    // f(Entity, Ts&...) za svaki entitet koji ima sve Ts i nijednu komponentu iz exclude.
+    // Unutar f nisu dozvoljene strukturne promene (add/remove/create/destroy).
+    template <typename... Ts, typename F>
+    void each(F&& f, ComponentMask exclude = 0)
+    {
+        const ComponentMask required = componentMask<Ts...>();
+        for (auto& arch : m_archetypes)
+        {
+            if ((arch->m_mask & required) != required || (arch->m_mask & exclude) || arch->size() == 0)
+                continue;
+
+            std::tuple<Ts*...> columns(arch->template column<Ts>()...);
+            const Entity* entities = arch->getEntities();
+            const unsigned int count = arch->size();
+            for (unsigned int i = 0; i < count; i++)
+                f(entities[i], std::get<Ts*>(columns)[i]...);
+        }
+    }
+
+    unsigned int getEntityCount() const { return m_aliveCount; }
+    unsigned int getArchetypeCount() const { return (unsigned int)m_archetypes.size(); }
+
+private:
+    struct Record
+    {
+        unsigned int archetype = 0;
+        unsigned int row = 0;
+        unsigned int generation = 0;
+        bool alive = false;
+    };
+
+    template <typename T>
+    unsigned int registerComponent()
+    {
+        const unsigned int type = componentId<T>();
+        if (m_componentSizes.size() <= type) m_componentSizes.resize(type + 1, 0);
+        m_componentSizes[type] = sizeof(T);
+        return type;
+    }
+
+    unsigned int getOrCreateArchetype(ComponentMask mask);
+    void moveEntity(Entity e, unsigned int target);
+    void removeRow(unsigned int archetype, unsigned int row);
+
+private:
+    std::vector<Record> m_records;
+    std::vector<unsigned int> m_freeIndices;
+    unsigned int m_aliveCount = 0;
+
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;
+    std::unordered_map<ComponentMask, unsigned int> m_archetypeByMask;
+    std::vector<size_t> m_componentSizes;
+};
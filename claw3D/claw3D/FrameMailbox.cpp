@@ -0,0 +1,41 @@
+#include "FrameMailbox.h"
+
+#include <utility>
+
+void FrameMailbox::publish()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_mode == Mode::Double)
+        m_cv.wait(lock, [this] { return !m_fresh || m_closed; });
+
+    if (m_fresh) m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+    std::swap(m_write, m_ready);
+    m_fresh = true;
+
+    lock.unlock();
+    m_cv.notify_all();
+}
+
+const FramePacket* FrameMailbox::acquire()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_fresh || m_closed; });
+    if (m_closed) return nullptr;
+
+    std::swap(m_read, m_ready);
+    m_fresh = false;
+
+    lock.unlock();
+    m_cv.notify_all();      // Double: simulacija ceka da se slot oslobodi
+    return &m_slots[m_read];
+}
+
+void FrameMailbox::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_cv.notify_all();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "FramePacket.h"
+
+// Predaja paketa simulacija -> render nit. Tri slota: u jedan pise simulacija, iz jednog
+// crta render nit, treci je poslednji objavljeni. Slotovi se samo zamenjuju (indeksi pod
+// mutex-om), a vektori u paketima zadrzavaju kapacitet, pa posle zagrevanja nema alokacija.
+//
+// Triple: simulacija nikad ne ceka; neprocitan paket se pregazi novijim (broji se kao preskocen).
+// Double: publish() ceka da render nit preuzme prethodni paket, pa je simulacija najvise
+// jedan frejm ispred crtanja (manje kasnjenje, ali spora strana usporava drugu).
+class FrameMailbox
+{
+public:
+    enum class Mode { Double, Triple };
+
+    explicit FrameMailbox(Mode mode) : m_mode(mode) {}
+
+    FrameMailbox(const FrameMailbox&) = delete;
+    FrameMailbox& operator=(const FrameMailbox&) = delete;
+
+    // slot simulacije; sadrzi paket od pre tri objave (puni se ispocetka)
+    FramePacket& beginWrite() { return m_slots[m_write]; }
+    void publish();
+
+    // render nit: ceka nov paket; nullptr kad je mailbox zatvoren
+    const FramePacket* acquire();
+    void close();
+
+    Mode getMode() const { return m_mode; }
+    unsigned int getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    Mode m_mode;
+    FramePacket m_slots[3];
+
+    // m_write pripada simulaciji, m_read render niti; m_ready menja vlasnika pod mutex-om
+    unsigned int m_write = 0;
+    unsigned int m_ready = 1;
+    unsigned int m_read = 2;
+    bool m_fresh = false;       // m_ready jos nije preuzet
+    bool m_closed = false;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<unsigned int> m_dropped{ 0 };
+};
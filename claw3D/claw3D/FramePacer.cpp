@@ -0,0 +1,135 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+namespace
+{
+    const float kMinSpinMarginMs = 0.25f;
+    const float kMaxSpinMarginMs = 4.0f;
+
+    float toMs(FramePacer::Clock::duration d)
+    {
+        return std::chrono::duration<float, std::milli>(d).count();
+    }
+
+    float percentile(const std::vector<float>& sorted, float p)
+    {
+        const size_t i = std::min(sorted.size() - 1, (size_t)(p * (float)(sorted.size() - 1) + 0.5f));
+        return sorted[i];
+    }
+}
+
+const unsigned int FramePacer::kHistory;
+
+FramePacer::FramePacer()
+{
+#ifdef _WIN32
+    // podrazumevani kvant je ~15.6 ms; sa 1 ms sleep_for ostavlja mnogo manje za spin
+    timeBeginPeriod(1);
+#endif
+    m_errors.reserve(kHistory);
+}
+
+FramePacer::~FramePacer()
+{
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::setTargetRate(float hz)
+{
+    m_targetHz = hz > 0.0f ? hz : 0.0f;
+    m_period = m_targetHz > 0.0f
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_targetHz))
+        : Clock::duration(0);
+    m_started = false;
+}
+
+FramePacer::Clock::time_point FramePacer::wait()
+{
+    Clock::time_point now = Clock::now();
+    if (m_period.count() == 0) return now;
+
+    if (!m_started)
+    {
+        m_started = true;
+        m_deadline = now;
+        return now;
+    }
+
+    m_deadline += m_period;
+
+    if (now >= m_deadline)
+    {
+        // kasni; posle celog propustenog perioda rok se pomera, inace bi usledio niz frejmova bez cekanja
+        record(toMs(now - m_deadline));
+        if (now - m_deadline >= m_period)
+        {
+            m_missed++;
+            m_deadline = now;
+        }
+        return now;
+    }
+
+    // ===== 1. SLEEP DO MARGINE =====
+    const float remainingMs = toMs(m_deadline - now);
+    if (remainingMs > m_spinMarginMs)
+    {
+        const std::chrono::duration<float, std::milli> request(remainingMs - m_spinMarginMs);
+        std::this_thread::sleep_for(request);
+
+        // margina prati prekoracenje sleep-a: brzo raste, polako opada
+        const float overshootMs = toMs(Clock::now() - now) - request.count();
+        m_spinMarginMs = std::max(overshootMs * 1.5f, m_spinMarginMs * 0.98f);
+        m_spinMarginMs = std::min(std::max(m_spinMarginMs, kMinSpinMarginMs), kMaxSpinMarginMs);
+    }
+
+    // ===== 2. SPIN DO ROKA =====
+    while ((now = Clock::now()) < m_deadline)
+        std::this_thread::yield();
+
+    record(toMs(now - m_deadline));
+    return now;
+}
+
+void FramePacer::record(float errorMs)
+{
+    if (m_errors.size() < kHistory)
+        m_errors.push_back(errorMs);
+    else
+        m_errors[m_next] = errorMs;
+    m_next = (m_next + 1) % kHistory;
+}
+
+FramePacer::Report FramePacer::getReport() const
+{
+    Report report;
+    report.frames = (unsigned int)m_errors.size();
+    report.missed = m_missed;
+    report.spinMarginMs = m_spinMarginMs;
+    if (m_errors.empty()) return report;
+
+    std::vector<float> sorted = m_errors;
+    std::sort(sorted.begin(), sorted.end());
+    report.p50Ms = percentile(sorted, 0.50f);
+    report.p95Ms = percentile(sorted, 0.95f);
+    report.p99Ms = percentile(sorted, 0.99f);
+    report.maxMs = sorted.back();
+    return report;
+}
+
+void FramePacer::resetReport()
+{
+    m_errors.clear();
+    m_next = 0;
+    m_missed = 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <vector>
+
+// Ogranicavac frejmova sa apsolutnim rokovima (rok += period, pa se greska ne nagomilava).
+// Ceka hibridno: sleep_for do "margine" pre roka, pa spin do samog roka. Margina se prilagodjava
+// izmerenom prekoracenju sleep-a (kvant rasporedjivaca), tako da spin traje koliko mora.
+// Greska ritma = koliko je budjenje zakasnilo za rokom; cuva se za poslednjih kHistory frejmova.
+class FramePacer
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static const unsigned int kHistory = 512;
+
+    struct Report
+    {
+        unsigned int frames = 0;        // uzoraka u istoriji
+        unsigned int missed = 0;        // frejmova koji su kasnili ceo period (rok se pomera na sada)
+        float p50Ms = 0.0f;
+        float p95Ms = 0.0f;
+        float p99Ms = 0.0f;
+        float maxMs = 0.0f;
+        float spinMarginMs = 0.0f;
+    };
+
+    FramePacer();
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    // 0 = bez ogranicenja (wait() se odmah vraca, npr. kad ritam drzi vsync)
+    void setTargetRate(float hz);
+    float getTargetRate() const { return m_targetHz; }
+
+    // ceka rok sledeceg frejma; vraca trenutak budjenja (pocetak frejma)
+    Clock::time_point wait();
+    // sledeci wait() pocinje novi niz rokova (posle pauze se ne sustizu propusteni frejmovi)
+    void restart() { m_started = false; }
+
+    Report getReport() const;
+    void resetReport();
+
+private:
+    void record(float errorMs);
+
+private:
+    float m_targetHz = 0.0f;
+    Clock::duration m_period{ 0 };
+    Clock::time_point m_deadline;
+    bool m_started = false;
+
+    float m_spinMarginMs = 2.0f;
+
+    std::vector<float> m_errors;        // prstenasti bafer, ms
+    unsigned int m_next = 0;
+    unsigned int m_missed = 0;
+};
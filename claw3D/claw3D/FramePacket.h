@@ -0,0 +1,58 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <glm/glm.hpp>
+
+class Mesh;
+
+// Classic: draw poziv po objektu; Batched: jedan instancirani poziv po (mesh, tekstura) grupi
+enum class RenderPath { Classic, Batched };
+
+// jedan vidljiv objekat, kopiran po vrednosti u trenutku pravljenja paketa
+struct DrawItem
+{
+    const Mesh* mesh;
+    unsigned int texture;       // 0 = bez teksture
+    glm::mat4 model;
+    glm::vec3 color;
+};
+
+// Sve sto GL strani treba za jedan frejm. Pravi ga simulacija (Application::buildFrame +
+// Scene::buildPacket) i posle objave ga vise ne menja; nema pokazivaca na GameObject-e, pa
+// objekat moze da bude unisten ili pomeren dok se paket crta. Mesh-evi i teksture su deljeni
+// resursi koji zive do gasenja.
+struct FramePacket
+{
+    unsigned int frameIndex = 0;
+
+    // najstariji ulazni dogadjaj primenjen u ovom frejmu (podrazumevano = nema ga);
+    // render strana posle swapBuffers racuna kasnjenje ulaz -> ekran
+    std::chrono::steady_clock::time_point inputTime;
+
+    // ===== KAMERA =====
+    glm::mat4 view{ 1.0f };
+    glm::mat4 projection{ 1.0f };
+    glm::vec3 viewPos{ 0.0f };
+
+    // ===== SVETLO =====
+    glm::vec3 lightPos{ 0.0f };
+    glm::vec3 lightColor{ 0.0f };
+    glm::vec3 ambientColor{ 1.0f };
+    float ambientStrength = 0.2f;
+
+    // ===== GL STANJE =====
+    bool depthTest = true;
+    bool cullFace = false;
+    RenderPath renderPath = RenderPath::Classic;
+    bool oit = true;
+
+    // pecena staticka geometrija (StaticBatch::getVertices); crta se cela cim je bar jedan
+    // njen objekat vidljiv. Niz je nepromenljiv, novo pecenje pravi novi.
+    std::shared_ptr<const std::vector<float>> staticVertices;
+    unsigned int staticObjectsVisible = 0;
+
+    // redosled iz culling-a; za Batched je opaque vec sortiran po (mesh, tekstura)
+    std::vector<DrawItem> opaque;
+    std::vector<DrawItem> transparent;
+};
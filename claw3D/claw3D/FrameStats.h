@@ -0,0 +1,49 @@
+#pragma once
+
+// brojaci za jedan frejm (resetuju se na pocetku Scene::update)
+struct FrameStats
+{
+    unsigned int objectsVisible = 0;
+    unsigned int objectsCulled = 0;
+    unsigned int objectsOccluded = 0;
+    float occlusionMs = 0.0f;
+
+    float bvhBuildMs = 0.0f;    // kompletna izgradnja (promena skupa objekata)
+    float bvhRefitMs = 0.0f;
+    float bvhRebuildMs = 0.0f;  // delimicna izgradnja degradiranih podstabala
+    unsigned int bvhSubtreesRebuilt = 0;
+
+    unsigned int objectsLive = 0;
+    unsigned int objectsDestroyed = 0;      // unisteni na pocetku ovog update-a (odlozeno)
+    unsigned int poolSlabsReleased = 0;
+    // ukupno od pokretanja (korak sa unistavanjem je redak, pa brojaci koraka su skoro uvek 0)
+    unsigned int objectsDestroyedTotal = 0;
+    unsigned int poolSlabsReleasedTotal = 0;
+
+    unsigned int staticObjectsBaked = 0;    // objekti u StaticBatch-u (crtaju se jednim pozivom)
+    bool staticBatchRebuilt = false;
+
+    // nesto vidljivo se promenilo (pomeren objekat, materijal, active, unisten objekat)
+    bool sceneChanged = false;
+};
+
+// brojaci GL strane za poslednji nacrtan frejm (SceneRenderer + GLState); pise ih nit koja drzi kontekst
+struct RenderStats
+{
+    unsigned int frameIndex = 0;        // FramePacket::frameIndex nacrtanog frejma
+    unsigned int drawCalls = 0;
+    unsigned int objectsDrawn = 0;
+    unsigned int batches = 0;
+
+    unsigned int glCallsIssued = 0;     // GLState: izdati / preskoceni pozivi
+    unsigned int glCallsElided = 0;
+
+    float submitMs = 0.0f;              // crtanje frejma bez swapBuffers
+    unsigned int framesDropped = 0;     // ukupno objavljenih frejmova koje render nit nije nacrtala
+
+    // ulaz -> ekran: od najstarijeg dogadjaja primenjenog u frejmu do povratka iz swapBuffers
+    float inputLatencyMs = 0.0f;        // poslednji uzorak
+    float inputLatencyMaxMs = 0.0f;     // ukupno od pokretanja
+    float inputLatencySumMs = 0.0f;
+    unsigned int inputLatencySamples = 0;
+};
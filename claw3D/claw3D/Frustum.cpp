@@ -0,0 +1,129 @@
+#include "Frustum.h"
+#include "Simd.h"
+
+Frustum::Frustum(const glm::mat4& m)
+{
+    // glm je column-major: red i = (m[0][i], m[1][i], m[2][i], m[3][i])
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    m_planes[0] = row3 + row0;  // levo
+    m_planes[1] = row3 - row0;  // desno
+    m_planes[2] = row3 + row1;  // dole
+    m_planes[3] = row3 - row1;  // gore
+    m_planes[4] = row3 + row2;  // near
+    m_planes[5] = row3 - row2;  // far
+
+    for (glm::vec4& p : m_planes)
+        p /= glm::length(glm::vec3(p));
+}
+
+bool Frustum::intersects(const BoundingSphere& s) const
+{
+    if (!s.valid()) return true;
+
+    for (const glm::vec4& p : m_planes)
+    {
+        if (glm::dot(glm::vec3(p), s.center) + p.w < -s.radius)
+            return false;
+    }
+    return true;
+}
+
+Frustum::Result Frustum::classify(const Aabb& box) const
+{
+    if (!box.valid()) return Result::Intersects;
+
+    glm::vec3 c = box.center();
+    glm::vec3 e = box.extents();
+    Result result = Result::Inside;
+
+    for (const glm::vec4& p : m_planes)
+    {
+        glm::vec3 n(p);
+        float d = glm::dot(n, c) + p.w;
+        float r = glm::dot(glm::abs(n), e);
+
+        if (d < -r) return Result::Outside;
+        if (d < r) result = Result::Intersects;
+    }
+    return result;
+}
+
+unsigned int Frustum::cullSpheres(const float* x, const float* y, const float* z, const float* r,
+    unsigned int count, unsigned char* visible) const
+{
+    unsigned int i = 0;
+    unsigned int visibleCount = 0;
+
+#if CLAW_SIMD_AVX
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(x + i);
+        __m256 cy = _mm256_loadu_ps(y + i);
+        __m256 cz = _mm256_loadu_ps(z + i);
+        __m256 cr = _mm256_loadu_ps(r + i);
+        __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), cr);
+
+        __m256 outside = _mm256_setzero_ps();
+        for (const glm::vec4& p : m_planes)
+        {
+            __m256 d = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(p.x)), _mm256_mul_ps(cy, _mm256_set1_ps(p.y))),
+                _mm256_add_ps(_mm256_mul_ps(cz, _mm256_set1_ps(p.z)), _mm256_set1_ps(p.w)));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, negR, _CMP_LT_OQ));
+        }
+        // kao intersects(): sfera bez granica (!(r >= 0)) je uvek vidljiva
+        outside = _mm256_andnot_ps(_mm256_cmp_ps(cr, _mm256_setzero_ps(), _CMP_NGE_UQ), outside);
+
+        int mask = _mm256_movemask_ps(outside);
+        for (int k = 0; k < 8; k++)
+        {
+            visible[i + k] = (mask & (1 << k)) ? 0 : 1;
+            visibleCount += visible[i + k];
+        }
+    }
+#endif
+
+#if CLAW_SIMD_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(x + i);
+        __m128 cy = _mm_loadu_ps(y + i);
+        __m128 cz = _mm_loadu_ps(z + i);
+        __m128 cr = _mm_loadu_ps(r + i);
+        __m128 negR = _mm_sub_ps(_mm_setzero_ps(), cr);
+
+        __m128 outside = _mm_setzero_ps();
+        for (const glm::vec4& p : m_planes)
+        {
+            __m128 d = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(p.x)), _mm_mul_ps(cy, _mm_set1_ps(p.y))),
+                _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(p.z)), _mm_set1_ps(p.w)));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negR));
+        }
+        outside = _mm_andnot_ps(_mm_cmpnge_ps(cr, _mm_setzero_ps()), outside);
+
+        int mask = _mm_movemask_ps(outside);
+        for (int k = 0; k < 4; k++)
+        {
+            visible[i + k] = (mask & (1 << k)) ? 0 : 1;
+            visibleCount += visible[i + k];
+        }
+    }
+#endif
+
+    // ostatak (i ceo niz bez SIMD-a)
+    for (; i < count; i++)
+    {
+        BoundingSphere s;
+        s.center = { x[i], y[i], z[i] };
+        s.radius = r[i];
+        visible[i] = intersects(s) ? 1 : 0;
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+class Frustum
+{
+public:
+    Frustum() = default;
+
+    // ravni se izvlace iz projection * view (Gribb/Hartmann), normalizovane, normala ka unutra
+    explicit Frustum(const glm::mat4& viewProj);
+
+    enum class Result { Outside, Intersects, Inside };
+
+    bool intersects(const BoundingSphere& s) const;
+    Result classify(const Aabb& box) const;
+
+    // SoA test: x/y/z/r nizovi duzine count; visible[i] = 1 ako je sfera (bar delimicno) unutra
+    // ili nema granica (r < 0), isto kao intersects().
+    // Obradjuje 8 (AVX) ili 4 (SSE) sfere po iteraciji; vraca broj vidljivih.
+    unsigned int cullSpheres(const float* x, const float* y, const float* z, const float* r,
+        unsigned int count, unsigned char* visible) const;
+
+    const glm::vec4& getPlane(int i) const { return m_planes[i]; }
+
+private:
+    glm::vec4 m_planes[6];
+};
@@ -0,0 +1,242 @@
+#include "GLState.h"
+
+namespace
+{
+    const unsigned int kUnknown = 0xFFFFFFFFu;
+    const int kTextureUnits = 16;
+
+    enum CapSlot { CapBlend, CapDepthTest, CapCullFace, CapCount };
+
+    struct Cache
+    {
+        int caps[CapCount];         // -1 = nepoznato, 0/1
+        GLenum blend[4];
+        int depthMask;
+        GLenum cullFace;
+
+        unsigned int program;
+        unsigned int vao;
+        unsigned int arrayBuffer;
+        unsigned int readFramebuffer;
+        unsigned int drawFramebuffer;
+
+        unsigned int activeUnit;
+        unsigned int textures[kTextureUnits];
+
+        Cache() { reset(); }
+
+        void reset()
+        {
+            for (int& c : caps) c = -1;
+            for (GLenum& b : blend) b = kUnknown;
+            depthMask = -1;
+            cullFace = kUnknown;
+            program = vao = arrayBuffer = kUnknown;
+            readFramebuffer = drawFramebuffer = kUnknown;
+            activeUnit = kUnknown;
+            for (unsigned int& t : textures) t = kUnknown;
+        }
+    };
+
+    Cache s_cache;
+    unsigned int s_defaultFramebuffer = 0;     // ne zavisi od kesa, invalidate() ga ne dira
+    GLState::Counters s_counters;
+
+    int capSlot(GLenum cap)
+    {
+        switch (cap)
+        {
+        case GL_BLEND:      return CapBlend;
+        case GL_DEPTH_TEST: return CapDepthTest;
+        case GL_CULL_FACE:  return CapCullFace;
+        default:            return -1;
+        }
+    }
+
+    // true = stanje se menja (poziv treba poslati)
+    template <typename T>
+    bool changes(T& cached, T value)
+    {
+        if (cached == value)
+        {
+            s_counters.elided++;
+            return false;
+        }
+        cached = value;
+        s_counters.issued++;
+        return true;
+    }
+
+    void setActiveUnit(unsigned int unit)
+    {
+        if (changes(s_cache.activeUnit, unit))
+            glActiveTexture(GL_TEXTURE0 + unit);
+    }
+}
+
+void GLState::enable(GLenum cap)
+{
+    setEnabled(cap, true);
+}
+
+void GLState::disable(GLenum cap)
+{
+    setEnabled(cap, false);
+}
+
+void GLState::setEnabled(GLenum cap, bool enabled)
+{
+    int slot = capSlot(cap);
+    if (slot >= 0 && !changes(s_cache.caps[slot], enabled ? 1 : 0)) return;
+    if (slot < 0) s_counters.issued++;
+
+    if (enabled) glEnable(cap);
+    else         glDisable(cap);
+}
+
+void GLState::blendFunc(GLenum src, GLenum dst)
+{
+    blendFuncSeparate(src, dst, src, dst);
+}
+
+void GLState::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+    GLenum* b = s_cache.blend;
+    if (b[0] == srcRGB && b[1] == dstRGB && b[2] == srcAlpha && b[3] == dstAlpha)
+    {
+        s_counters.elided++;
+        return;
+    }
+
+    b[0] = srcRGB; b[1] = dstRGB; b[2] = srcAlpha; b[3] = dstAlpha;
+    s_counters.issued++;
+    glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
+void GLState::depthMask(bool write)
+{
+    if (changes(s_cache.depthMask, write ? 1 : 0))
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+}
+
+void GLState::cullFace(GLenum mode)
+{
+    if (changes(s_cache.cullFace, mode))
+        glCullFace(mode);
+}
+
+void GLState::useProgram(unsigned int program)
+{
+    if (changes(s_cache.program, program))
+        glUseProgram(program);
+}
+
+void GLState::bindVertexArray(unsigned int vao)
+{
+    if (changes(s_cache.vao, vao))
+        glBindVertexArray(vao);
+}
+
+void GLState::bindArrayBuffer(unsigned int buffer)
+{
+    if (changes(s_cache.arrayBuffer, buffer))
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+}
+
+void GLState::bindFramebuffer(GLenum target, unsigned int fbo)
+{
+    if (target == GL_FRAMEBUFFER)
+    {
+        if (s_cache.readFramebuffer == fbo && s_cache.drawFramebuffer == fbo)
+        {
+            s_counters.elided++;
+            return;
+        }
+        s_cache.readFramebuffer = s_cache.drawFramebuffer = fbo;
+        s_counters.issued++;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        return;
+    }
+
+    unsigned int& cached = (target == GL_READ_FRAMEBUFFER) ? s_cache.readFramebuffer : s_cache.drawFramebuffer;
+    if (changes(cached, fbo))
+        glBindFramebuffer(target, fbo);
+}
+
+void GLState::bindTexture2D(unsigned int unit, unsigned int texture)
+{
+    if (unit >= (unsigned int)kTextureUnits)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        s_cache.activeUnit = unit;
+        s_counters.issued += 2;
+        return;
+    }
+
+    if (s_cache.textures[unit] == texture)
+    {
+        s_counters.elided++;
+        return;
+    }
+
+    setActiveUnit(unit);
+    s_cache.textures[unit] = texture;
+    s_counters.issued++;
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLState::onProgramDeleted(unsigned int program)
+{
+    if (s_cache.program == program) s_cache.program = kUnknown;
+}
+
+void GLState::onVertexArrayDeleted(unsigned int vao)
+{
+    if (s_cache.vao == vao) s_cache.vao = kUnknown;
+}
+
+void GLState::onBufferDeleted(unsigned int buffer)
+{
+    if (s_cache.arrayBuffer == buffer) s_cache.arrayBuffer = kUnknown;
+}
+
+void GLState::onTextureDeleted(unsigned int texture)
+{
+    for (unsigned int& t : s_cache.textures)
+    {
+        if (t == texture) t = kUnknown;
+    }
+}
+
+void GLState::setDefaultFramebuffer(unsigned int fbo)
+{
+    s_defaultFramebuffer = fbo;
+    bindFramebuffer(GL_FRAMEBUFFER, fbo);
+}
+
+unsigned int GLState::getDefaultFramebuffer()
+{
+    return s_defaultFramebuffer;
+}
+
+void GLState::onFramebufferDeleted(unsigned int fbo)
+{
+    if (s_cache.readFramebuffer == fbo) s_cache.readFramebuffer = kUnknown;
+    if (s_cache.drawFramebuffer == fbo) s_cache.drawFramebuffer = kUnknown;
+}
+
+void GLState::invalidate()
+{
+    s_cache.reset();
+}
+
+const GLState::Counters& GLState::getCounters()
+{
+    return s_counters;
+}
+
+void GLState::resetCounters()
+{
+    s_counters = Counters();
+}
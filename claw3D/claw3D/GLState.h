@@ -0,0 +1,48 @@
+#pragma once
+#include <glad/glad.h>
+
+// Tanak sloj iznad GL state poziva: pamti poslednje postavljeno stanje i preskace poziv
+// ako se nista ne menja. Svi moduli menjaju stanje preko njega (jedan GL kontekst).
+// Kad neko zaobidje GLState (ili posle brisanja objekata), invalidate() zaboravlja kes.
+class GLState
+{
+public:
+    struct Counters
+    {
+        unsigned int issued = 0;    // stvarno poslati GL pozivi
+        unsigned int elided = 0;    // preskoceni (stanje se vec poklapa)
+    };
+
+    static void enable(GLenum cap);
+    static void disable(GLenum cap);
+    static void setEnabled(GLenum cap, bool enabled);
+
+    static void blendFunc(GLenum src, GLenum dst);
+    static void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+    static void depthMask(bool write);
+    static void cullFace(GLenum mode);
+
+    static void useProgram(unsigned int program);
+    static void bindVertexArray(unsigned int vao);
+    static void bindArrayBuffer(unsigned int buffer);
+    static void bindFramebuffer(GLenum target, unsigned int fbo);
+
+    // framebuffer koji predstavlja ekran: 0, a u headless rezimu FBO prozora
+    static void setDefaultFramebuffer(unsigned int fbo);
+    static unsigned int getDefaultFramebuffer();
+
+    // aktivira jedinicu i veze GL_TEXTURE_2D
+    static void bindTexture2D(unsigned int unit, unsigned int texture);
+
+    // posle glDelete* za objekat koji je mozda vezan
+    static void onProgramDeleted(unsigned int program);
+    static void onVertexArrayDeleted(unsigned int vao);
+    static void onBufferDeleted(unsigned int buffer);
+    static void onTextureDeleted(unsigned int texture);
+    static void onFramebufferDeleted(unsigned int fbo);
+
+    static void invalidate();
+
+    static const Counters& getCounters();
+    static void resetCounters();
+};
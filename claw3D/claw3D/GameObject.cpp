@@ -3,12 +3,23 @@
 #include "Mesh.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "GLState.h"
+#include "Components.h"
 
-GameObject::GameObject(Mesh* mesh, std::string name_)
-    : name(std::move(name_)), m_mesh(mesh)
+GameObject::GameObject(Mesh* mesh, Name name)
+    : m_mesh(mesh), m_name(name)
 {
 }
 
+bool GameObject::hasTag(const Name& tag) const
+{
+    for (const Name& t : m_tags)
+    {
+        if (t == tag) return true;
+    }
+    return false;
+}
+
 void GameObject::setParent(GameObject* newParent)
 {
     if (m_parent == newParent) return;
@@ -17,6 +28,19 @@ void GameObject::setParent(GameObject* newParent)
     transform.setParent(newParent ? &newParent->transform : nullptr);
 }
 
+void GameObject::detach()
+{
+    if (m_parent) m_parent->m_children.removeSwap(this);
+    setParent(nullptr);
+
+    for (GameObject* child : m_children)
+    {
+        child->m_parent = nullptr;
+        child->transform.setParent(nullptr);
+    }
+    m_children.clear();
+}
+
 void GameObject::addChild(GameObject* child)
 {
     if (!child) return;
@@ -24,6 +48,20 @@ void GameObject::addChild(GameObject* child)
     m_children.push_back(child);
 }
 
+const BoundingSphere& GameObject::getWorldBounds() const
+{
+    static const BoundingSphere none;
+    const BoundsComponent* b = m_world ? m_world->get<BoundsComponent>(m_entity) : nullptr;
+    return b ? b->sphere : none;
+}
+
+const Aabb& GameObject::getWorldAabb() const
+{
+    static const Aabb none;
+    const BoundsComponent* b = m_world ? m_world->get<BoundsComponent>(m_entity) : nullptr;
+    return b ? b->aabb : none;
+}
+
 void GameObject::draw(const Shader& shader, const Camera& camera) const
 {
     if (!active || !m_mesh) return;
@@ -43,8 +81,7 @@ void GameObject::draw(const Shader& shader, const Camera& camera) const
     shader.setInt("u_UseTexture", (useTexture && texture != 0) ? 1 : 0);
     if (useTexture && texture != 0)
     {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        GLState::bindTexture2D(0, texture);
         shader.setInt("u_Texture", 0);
     }
 
@@ -1,8 +1,11 @@
 #pragma once
 #include "Transform.h"
+#include "Bounds.h"
+#include "Ecs.h"
+#include "Name.h"
+#include "ObjectPool.h"
+#include "SmallVector.h"
 //#include <glm/glm.hpp>
-#include <string>
-#include <vector>
 
 class Mesh;
 class Shader;
@@ -11,17 +14,44 @@ class Camera;
 class GameObject
 {
 public:
-    explicit GameObject(Mesh* mesh = nullptr, std::string name = "");
+    explicit GameObject(Mesh* mesh = nullptr, Name name = Name());
 
     void draw(const Shader& shader, const Camera& camera) const;
 
     void setParent(GameObject* newParent);
     void addChild(GameObject* child);
 
+    // izbacuje objekat iz hijerarhije (roditelj ga zaboravlja, deca postaju koreni)
+    void detach();
+
+    Mesh* getMesh() const { return m_mesh; }
+
+    // svetske granice (sfera + AABB) iz BoundsComponent-a; racuna ih Scene::update
+    const BoundingSphere& getWorldBounds() const;
+    const Aabb& getWorldAabb() const;
+
+    // veza sa scenom: ECS entitet + rucka u pool-u (postavlja Scene::createObject)
+    void attachToScene(EcsWorld* world, Entity entity, PoolHandle handle)
+    {
+        m_world = world;
+        m_entity = entity;
+        m_handle = handle;
+    }
+    Entity getEntity() const { return m_entity; }
+    PoolHandle getHandle() const { return m_handle; }
+
+    const SmallVector<GameObject*, 4>& getChildren() const { return m_children; }
+
+    // ime i tagovi se menjaju kroz Scene (renameObject/addTag) da bi indeks ostao tacan
+    const Name& getName() const { return m_name; }
+    const SmallVector<Name, 2>& getTags() const { return m_tags; }
+    bool hasTag(const Name& tag) const;
+
 public:
-    std::string name;
     bool active = true;
     bool transparent = false;
+    bool occluder = false;      // rasterizuje se u softverski depth bafer (OcclusionCuller)
+    bool isStatic = false;      // ne pomera se posle init-a -> pece se u StaticBatch
 
     Transform transform;
     glm::vec3 color{ 1.0f, 0.0f, 0.0f };
@@ -29,8 +59,21 @@ public:
     unsigned int texture = 0;   // 0 = nema teksture
     bool useTexture = false;
 private:
+    friend class Scene;
+
     Mesh* m_mesh = nullptr;
 
+    Name m_name;                // internovano (vidi Name.h)
+    SmallVector<Name, 2> m_tags;
+
+    // mesto u kofi Scene indeksa (uklanjanje bez pretrage): ime, pa tag po tag kao m_tags
+    unsigned int m_nameSlot = 0;
+    SmallVector<unsigned int, 2> m_tagSlots;
+
     GameObject* m_parent = nullptr;
-    std::vector<GameObject*> m_children;
+    SmallVector<GameObject*, 4> m_children;    // prsti kandze staju bez heap alokacije
+
+    EcsWorld* m_world = nullptr;
+    Entity m_entity;
+    PoolHandle m_handle;
 };
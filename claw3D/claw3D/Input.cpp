@@ -0,0 +1,83 @@
+#include "Input.h"
+
+#include <GLFW/glfw3.h>
+
+static_assert(Input::kKeyCount == GLFW_KEY_LAST + 1, "Input::kKeyCount mora da prati GLFW_KEY_LAST");
+static_assert(Input::kButtonCount == GLFW_MOUSE_BUTTON_LAST + 1, "Input::kButtonCount mora da prati GLFW_MOUSE_BUTTON_LAST");
+
+const int Input::kKeyCount;
+const int Input::kButtonCount;
+const int Input::kCodeCount;
+
+void Input::attach(GLFWwindow* window)
+{
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, &Input::onKey);
+    glfwSetMouseButtonCallback(window, &Input::onMouseButton);
+    glfwSetWindowRefreshCallback(window, &Input::onRefresh);
+}
+
+void Input::onKey(GLFWwindow* window, int key, int, int action, int)
+{
+    // GLFW_REPEAT ne menja stanje; nepoznati tasteri dolaze kao GLFW_KEY_UNKNOWN (-1)
+    if (action == GLFW_REPEAT || !valid(key)) return;
+
+    static_cast<Input*>(glfwGetWindowUserPointer(window))->post(key, action == GLFW_PRESS);
+}
+
+void Input::onMouseButton(GLFWwindow* window, int button, int action, int)
+{
+    if (button < 0 || button >= kButtonCount) return;
+
+    static_cast<Input*>(glfwGetWindowUserPointer(window))->post(kKeyCount + button, action == GLFW_PRESS);
+}
+
+void Input::onRefresh(GLFWwindow* window)
+{
+    static_cast<Input*>(glfwGetWindowUserPointer(window))->m_redrawRequested = true;
+}
+
+bool Input::takeRedrawRequest()
+{
+    const bool requested = m_redrawRequested;
+    m_redrawRequested = false;
+    return requested;
+}
+
+void Input::post(int code, bool down)
+{
+    m_live[code] = down;
+
+    Event e;
+    e.time = Clock::now();
+    e.code = (int16_t)code;
+    e.down = down;
+    if (!m_queue.push(e)) m_dropped++;
+}
+
+void Input::beginStep(Clock::time_point stepEnd)
+{
+    m_pressed.reset();
+
+    // red je hronoloski: staje se na prvom dogadjaju koji pripada nekom od sledecih koraka
+    while (const Event* e = m_queue.peek())
+    {
+        if (e->time > stepEnd) break;
+
+        // pritisak i pustanje u istom koraku: taster nije drzan, ali je pritisak zabelezen
+        if (e->down && !m_down[e->code]) m_pressed[e->code] = true;
+        m_down[e->code] = e->down;
+
+        if (m_oldestApplied == Clock::time_point() || e->time < m_oldestApplied)
+            m_oldestApplied = e->time;
+
+        m_queue.pop();
+    }
+}
+
+Input::Clock::time_point Input::takeOldestApplied()
+{
+    Clock::time_point t = m_oldestApplied;
+    m_oldestApplied = Clock::time_point();
+    return t;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include "SpscQueue.h"
+
+struct GLFWwindow;
+
+// Ulaz preko GLFW callback-a umesto glfwGetKey svakog frejma. Svaki pritisak/pustanje ide
+// u lock-free red sa vremenom kad ga je GLFW isporucio (glfwPollEvents); korak simulacije
+// primenjuje samo dogadjaje nastale do svog kraja, pa i taster pritisnut i pusten izmedju
+// dva frejma stigne u korak kome pripada (wasPressed), umesto da se izgubi.
+// Callback-i i potrosac su danas na glavnoj niti; red je ipak SPSC, da bi proizvodjac mogao da se izdvoji.
+class Input
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // tasteri misa dele prostor kodova sa tastaturom, posle GLFW_KEY_LAST
+    static const int kKeyCount = 349;       // GLFW_KEY_LAST + 1
+    static const int kButtonCount = 8;      // GLFW_MOUSE_BUTTON_LAST + 1
+    static const int kCodeCount = kKeyCount + kButtonCount;
+
+    struct Event
+    {
+        Clock::time_point time;
+        int16_t code;
+        bool down;
+    };
+
+    // postavlja callback-e (i user pointer) prozora
+    void attach(GLFWwindow* window);
+
+    // ===== KORAK SIMULACIJE =====
+    // primenjuje dogadjaje do stepEnd; wasPressed/wasClicked vaze do sledeceg poziva
+    void beginStep(Clock::time_point stepEnd);
+
+    bool isDown(int key) const { return valid(key) && m_down[key]; }
+    bool wasPressed(int key) const { return valid(key) && m_pressed[key]; }
+    bool isButtonDown(int button) const { return isDown(kKeyCount + button); }
+    bool wasClicked(int button) const { return wasPressed(kKeyCount + button); }
+
+    // poslednje isporuceno stanje, ukljucujuci dogadjaje koji jos cekaju korak (kamera)
+    bool isDownNow(int key) const { return valid(key) && m_live[key]; }
+
+    // najstariji dogadjaj primenjen od prethodnog poziva (Clock::time_point() ako ga nema);
+    // putuje u FramePacket radi merenja kasnjenja ulaz -> ekran
+    Clock::time_point takeOldestApplied();
+
+    unsigned int getDroppedCount() const { return m_dropped; }
+
+    // prozor trazi ponovno crtanje (otkriven, promenjena velicina); true jednom po zahtevu
+    bool takeRedrawRequest();
+
+    // dogadjaj kao iz callback-a, sa trenutnim vremenom (Scenario)
+    void inject(int code, bool down) { if (valid(code)) post(code, down); }
+
+private:
+    static bool valid(int code) { return code >= 0 && code < kCodeCount; }
+
+    static void onKey(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void onMouseButton(GLFWwindow* window, int button, int action, int mods);
+    static void onRefresh(GLFWwindow* window);
+    void post(int code, bool down);
+
+private:
+    SpscQueue<Event, 256> m_queue;
+    unsigned int m_dropped = 0;
+
+    std::bitset<kCodeCount> m_down;
+    std::bitset<kCodeCount> m_pressed;
+    std::bitset<kCodeCount> m_live;     // pise ga callback
+
+    Clock::time_point m_oldestApplied;
+    bool m_redrawRequested = false;
+};
@@ -0,0 +1,104 @@
+#include "JobSelfTest.h"
+#include "JobSystem.h"
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    bool fail(const char* test, unsigned int iteration)
+    {
+        std::cerr << "JobSystem selftest: " << test << " failed (iteration " << iteration << ")\n";
+        return false;
+    }
+
+    // svaki element tacno jednom, i kad count nije deljiv sa grain
+    bool testParallelFor(JobSystem& jobs)
+    {
+        const unsigned int count = 10000;
+        std::vector<unsigned int> hits(count, 0);
+        jobs.parallelFor(count, 97, [&hits](unsigned int begin, unsigned int end)
+            {
+                for (unsigned int i = begin; i < end; i++) hits[i]++;
+            });
+
+        for (unsigned int h : hits)
+            if (h != 1) return false;
+        return true;
+    }
+
+    // nastavak vidi sve poslove zavisnosti; drugi runAfter na vec gotovu zavisnost krece odmah
+    bool testRunAfter(JobSystem& jobs)
+    {
+        JobCounter first, second, late;
+        std::atomic<int> stage{ 0 };
+        std::atomic<int> bad{ 0 };
+
+        for (int k = 0; k < 8; k++)
+            jobs.run([&stage] { stage.fetch_add(1); }, &first);
+
+        jobs.runAfter(first, [&] { if (stage.load() != 8) bad++; stage.fetch_add(100); }, &second);
+        jobs.wait(second);
+
+        jobs.runAfter(first, [&] { stage.fetch_add(1000); }, &late);
+        jobs.wait(late);
+
+        return bad == 0 && stage.load() == 1108;
+    }
+
+    // lanac a -> b -> c i vise nastavaka na istom brojacu
+    bool testContinuationChain(JobSystem& jobs)
+    {
+        JobCounter a, b, c;
+        std::atomic<int> order{ 0 };
+        std::atomic<int> bad{ 0 };
+
+        jobs.run([&] { order.store(1); }, &a);
+        for (int k = 0; k < 4; k++)
+            jobs.runAfter(a, [&] { if (order.load() < 1) bad++; }, &b);
+        jobs.runAfter(b, [&] { if (order.load() != 1) bad++; order.store(2); }, &c);
+        jobs.wait(c);
+
+        return bad == 0 && order.load() == 2;
+    }
+
+    // poslovi koji sami zakazuju i cekaju (parallelFor u poslu)
+    bool testNested(JobSystem& jobs)
+    {
+        JobCounter outer;
+        std::atomic<int> sum{ 0 };
+        for (int k = 0; k < 4; k++)
+        {
+            jobs.run([&] { jobs.parallelFor(100, 7, [&sum](unsigned int begin, unsigned int end) { sum += (int)(end - begin); }); },
+                &outer);
+        }
+        jobs.wait(outer);
+
+        return sum.load() == 400;
+    }
+}
+
+bool runJobSelfTest(unsigned int iterations, unsigned int workerCount)
+{
+    // poseban sistem: ne zavisi od broja jezgara masine, a kradja se sigurno desava
+    JobSystem jobs(workerCount);
+
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        if (!testParallelFor(jobs)) return fail("parallelFor", i);
+        if (!testRunAfter(jobs)) return fail("runAfter", i);
+        if (!testContinuationChain(jobs)) return fail("continuation chain", i);
+        if (!testNested(jobs)) return fail("nested jobs", i);
+    }
+
+    unsigned int executed = 0, stolen = 0;
+    for (const JobSystem::WorkerStats& w : jobs.getStats())
+    {
+        executed += w.jobs;
+        stolen += w.stolen;
+    }
+    std::cout << "JobSystem selftest: " << iterations << " iteracija, " << jobs.getThreadCount() << " niti, "
+        << executed << " poslova (" << stolen << " ukradeno) - OK\n";
+    return true;
+}
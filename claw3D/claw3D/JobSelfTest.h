@@ -0,0 +1,7 @@
+#pragma once
+
+// Provera JobSystem-a pod opterecenjem: parallelFor (svaki element tacno jednom), runAfter
+// (nastavci tek posle zavisnosti, i kad je zavisnost vec gotova), lanci nastavaka i
+// ugnjezdeni poslovi. Najkorisnije u buildu sa ThreadSanitizer-om (-fsanitize=thread).
+// Pokrece se sa: claw3D --selftest-jobs [iteracija]; false (+ poruka) pri prvoj gresci
+bool runJobSelfTest(unsigned int iterations = 2000, unsigned int workerCount = 4);
@@ -0,0 +1,228 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <chrono>
+
+namespace
+{
+    // indeks reda tekuce niti; 0 za glavnu i sve niti koje nisu radnici
+    thread_local unsigned int t_queueIndex = 0;
+    thread_local const JobSystem* t_owner = nullptr;
+}
+
+JobSystem& JobSystem::instance()
+{
+    static JobSystem system;
+    return system;
+}
+
+JobSystem::JobSystem(unsigned int workerCount)
+{
+    if (workerCount == 0)
+    {
+        unsigned int hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 0;
+    }
+
+    for (unsigned int i = 0; i <= workerCount; i++)
+        m_queues.emplace_back(new Queue());
+
+    for (unsigned int i = 1; i <= workerCount; i++)
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_quit = true;
+    }
+    m_sleepCv.notify_all();
+
+    for (std::thread& t : m_workers)
+        t.join();
+}
+
+unsigned int JobSystem::currentIndex() const
+{
+    return t_owner == this ? t_queueIndex : 0;
+}
+
+void JobSystem::run(std::function<void()> fn, JobCounter* counter)
+{
+    if (counter) counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+    Job job;
+    job.fn = std::move(fn);
+    job.counter = counter;
+    push(std::move(job));
+}
+
+void JobSystem::runAfter(JobCounter& dependency, std::function<void()> fn, JobCounter* counter)
+{
+    if (counter) counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+    Job job;
+    job.fn = std::move(fn);
+    job.counter = counter;
+
+    {
+        // finish() prazni nastavke pod istim mutex-om -> nastavak se ne moze izgubiti
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (!dependency.isDone())
+        {
+            dependency.m_continuations.push_back(std::move(job));
+            return;
+        }
+    }
+    push(std::move(job));
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    const unsigned int index = currentIndex();
+    while (!counter.isDone())
+    {
+        Job job;
+        if (findJob(index, job))
+            execute(index, job);
+        else
+            std::this_thread::yield();      // preostali poslovi se vec izvrsavaju na drugim nitima
+    }
+
+    // sacekaj da nit koja je spustila brojac na nulu izadje iz finish()
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::push(Job job)
+{
+    // brojac raste pre ubacivanja, da ga kradja nikad ne spusti ispod nule
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    Queue& q = *m_queues[currentIndex()];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.jobs.push_back(std::move(job));
+    }
+
+    if (m_workers.empty()) return;
+
+    // prazan lock: radnik koji je upravo proverio m_queued je sigurno vec u wait-u
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_sleepCv.notify_one();
+}
+
+bool JobSystem::findJob(unsigned int index, Job& out)
+{
+    if (m_queued.load(std::memory_order_acquire) == 0) return false;
+
+    // svoj red: najnoviji posao (topli podaci u kesu)
+    {
+        Queue& own = *m_queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            out = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // kradja: najstariji posao iz tudjeg reda, redom od sledece niti
+    const unsigned int count = (unsigned int)m_queues.size();
+    for (unsigned int k = 1; k < count; k++)
+    {
+        Queue& victim = *m_queues[(index + k) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            out = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            m_queues[index]->stolenCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(unsigned int index, Job& job)
+{
+    using clock = std::chrono::steady_clock;
+    auto t0 = clock::now();
+
+    {
+        PROFILE_ZONE("job");
+        job.fn();
+    }
+
+    Queue& q = *m_queues[index];
+    q.busyNs.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count(),
+        std::memory_order_relaxed);
+    q.jobCount.fetch_add(1, std::memory_order_relaxed);
+
+    finish(job.counter);
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+    if (!counter) return;
+
+    // spustanje na nulu i preuzimanje nastavaka pod mutex-om brojaca: wait() ga zakljuca
+    // pre povratka, pa posle unlock-a ova nit vise ne dira brojac (sme da bude unisten)
+    std::vector<Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            ready.swap(counter->m_continuations);
+    }
+    for (Job& job : ready)
+        push(std::move(job));
+}
+
+void JobSystem::workerLoop(unsigned int index)
+{
+    t_queueIndex = index;
+    t_owner = this;
+    PROFILE_THREAD("worker " + std::to_string(index));
+
+    for (;;)
+    {
+        Job job;
+        if (findJob(index, job))
+        {
+            execute(index, job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepCv.wait(lock, [this] { return m_quit || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_quit) return;
+    }
+}
+
+std::vector<JobSystem::WorkerStats> JobSystem::getStats() const
+{
+    std::vector<WorkerStats> stats(m_queues.size());
+    for (size_t i = 0; i < m_queues.size(); i++)
+    {
+        const Queue& q = *m_queues[i];
+        stats[i].jobs = q.jobCount.load(std::memory_order_relaxed);
+        stats[i].stolen = q.stolenCount.load(std::memory_order_relaxed);
+        stats[i].busyMs = (float)q.busyNs.load(std::memory_order_relaxed) * 1e-6f;
+    }
+    return stats;
+}
+
+void JobSystem::resetStats()
+{
+    for (auto& q : m_queues)
+    {
+        q->jobCount.store(0, std::memory_order_relaxed);
+        q->stolenCount.store(0, std::memory_order_relaxed);
+        q->busyNs.store(0, std::memory_order_relaxed);
+    }
+}
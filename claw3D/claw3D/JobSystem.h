@@ -0,0 +1,126 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter;
+
+struct Job
+{
+    std::function<void()> fn;
+    JobCounter* counter = nullptr;      // umanjuje se kad se posao zavrsi
+};
+
+// Brojac nezavrsenih poslova. Raste pri zakazivanju, opada kad se posao zavrsi; poslovi
+// zakazani sa runAfter(counter, ...) krecu tek kad ovaj brojac padne na nulu.
+// Sme da se unisti tek posle JobSystem::wait(counter) (isDone() nije dovoljno).
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<unsigned int> m_pending{ 0 };
+    std::mutex m_mutex;
+    std::vector<Job> m_continuations;
+};
+
+// Work-stealing rasporedjivac: svaka nit ima svoj red (vlasnik uzima sa kraja, LIFO, dok ostali
+// kradu sa pocetka, FIFO). Nit 0 je glavna nit (i svaka druga nit koja nije radnik);
+// ona nikad ne spava u wait()/parallelFor, nego izvrsava poslove dok brojac ne padne na nulu.
+class JobSystem
+{
+public:
+    // brojaci od poslednjeg resetStats() (Application ih resetuje svaki frejm)
+    struct WorkerStats
+    {
+        unsigned int jobs = 0;
+        unsigned int stolen = 0;        // od toga ukradeno iz tudjeg reda
+        float busyMs = 0.0f;
+    };
+
+    static JobSystem& instance();
+
+    explicit JobSystem(unsigned int workerCount = 0);     // 0 = broj jezgara - 1
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void run(std::function<void()> fn, JobCounter* counter = nullptr);
+
+    // fn ide u red tek kad dependency padne na nulu (counter raste odmah)
+    void runAfter(JobCounter& dependency, std::function<void()> fn, JobCounter* counter = nullptr);
+
+    // pozivalac izvrsava poslove (svoje ili ukradene) dok counter ne padne na nulu
+    void wait(JobCounter& counter);
+
+    // fn(begin, end) nad [0, count) u komadima od grain elemenata; prvi komad radi pozivalac.
+    // Vraca se kad su svi komadi gotovi.
+    template <typename F>
+    void parallelFor(unsigned int count, unsigned int grain, F&& fn)
+    {
+        if (count == 0) return;
+        grain = std::max(grain, 1u);
+        if (count <= grain || m_workers.empty())
+        {
+            fn(0u, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (unsigned int begin = grain; begin < count; begin += grain)
+        {
+            const unsigned int end = std::min(begin + grain, count);
+            run([&fn, begin, end] { fn(begin, end); }, &counter);
+        }
+
+        fn(0u, grain);
+        wait(counter);
+    }
+
+    unsigned int getThreadCount() const { return (unsigned int)m_queues.size(); }
+
+    std::vector<WorkerStats> getStats() const;
+    void resetStats();
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+
+        std::atomic<unsigned int> jobCount{ 0 };
+        std::atomic<unsigned int> stolenCount{ 0 };
+        std::atomic<uint64_t> busyNs{ 0 };
+    };
+
+    unsigned int currentIndex() const;
+    void push(Job job);
+    bool findJob(unsigned int index, Job& out);
+    void execute(unsigned int index, Job& job);
+    void finish(JobCounter* counter);
+    void workerLoop(unsigned int index);
+
+private:
+    std::vector<std::unique_ptr<Queue>> m_queues;   // 0 = glavna nit, 1.. = radnici
+    std::vector<std::thread> m_workers;
+
+    std::atomic<unsigned int> m_queued{ 0 };
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCv;
+    bool m_quit = false;
+};
@@ -1,5 +1,7 @@
 ﻿#include "Mesh.h"
 #include <glad/glad.h>
+#include "GLState.h"
+#include "Profiler.h"
 
 #include <fstream>
 #include <sstream>
@@ -24,6 +26,8 @@ static bool parseOBJ(
     unsigned int& outVertexCount
 )
 {
+    PROFILE_ZONE("parseOBJ");
+
     std::ifstream file(path);
     if (!file.is_open()) return false;
 
@@ -180,12 +184,21 @@ void Mesh::upload(const float* vertices, unsigned int vertexCount, unsigned int
     m_vertexCount = vertexCount;
     m_strideFloats = strideFloats;
 
+    m_vertices.assign(vertices, vertices + (size_t)vertexCount * strideFloats);
+
+    m_bounds = Aabb();
+    for (unsigned int i = 0; i < vertexCount; i++)
+    {
+        const float* p = vertices + (size_t)i * strideFloats;
+        m_bounds.expand({ p[0], p[1], p[2] });
+    }
+
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(1, &m_VBO);
 
-    glBindVertexArray(m_VAO);
+    GLState::bindVertexArray(m_VAO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    GLState::bindArrayBuffer(m_VBO);
     glBufferData(
         GL_ARRAY_BUFFER,
         (size_t)vertexCount * strideFloats * sizeof(float),
@@ -210,20 +223,53 @@ void Mesh::upload(const float* vertices, unsigned int vertexCount, unsigned int
             (void*)(6 * sizeof(float)));
         glEnableVertexAttribArray(2);
     }
-
-    glBindVertexArray(0);
 }
 
 Mesh::~Mesh()
 {
-    if (m_VBO) glDeleteBuffers(1, &m_VBO);
-    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
+    if (m_VBO)
+    {
+        glDeleteBuffers(1, &m_VBO);
+        GLState::onBufferDeleted(m_VBO);
+    }
+    if (m_VAO)
+    {
+        glDeleteVertexArrays(1, &m_VAO);
+        GLState::onVertexArrayDeleted(m_VAO);
+    }
 }
 
 void Mesh::draw() const
 {
     if (!m_VAO || m_vertexCount == 0) return;
-    glBindVertexArray(m_VAO);
+
+    // VAO ostaje vezan; sledeci bind istog mesh-a se preskace
+    GLState::bindVertexArray(m_VAO);
     glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
-    glBindVertexArray(0);
 }
+
+
+void Mesh::drawInstanced(unsigned int instanceBuffer, size_t byteOffset, unsigned int instanceCount) const
+{
+    if (!m_VAO || m_vertexCount == 0 || instanceCount == 0) return;
+
+    GLState::bindVertexArray(m_VAO);
+    GLState::bindArrayBuffer(instanceBuffer);
+
+    // GL 3.3 nema baseInstance, pa se pokazivaci pomeraju na pocetak bucket-a
+    const GLsizei stride = sizeof(MeshInstance);
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, stride,
+            (void*)(byteOffset + offsetof(MeshInstance, model) + i * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(3 + i);
+        glVertexAttribDivisor(3 + i, 1);
+    }
+
+    glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, stride,
+        (void*)(byteOffset + offsetof(MeshInstance, color)));
+    glEnableVertexAttribArray(7);
+    glVertexAttribDivisor(7, 1);
+
+    glDrawArraysInstanced(GL_TRIANGLES, 0, m_vertexCount, instanceCount);
+}
\ No newline at end of file
@@ -1,5 +1,16 @@
 #pragma once
 #include <string>
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+// po-instanci zapis u instance baferu (atributi 3..7 u instanced.vert)
+struct MeshInstance
+{
+    glm::mat4 model;
+    glm::vec4 color;
+};
 
 class Mesh
 {
@@ -14,6 +25,17 @@ public:
 
     void draw() const;
 
+    // crta instanceCount instanci; zapisi pocinju na byteOffset u instanceBuffer-u
+    void drawInstanced(unsigned int instanceBuffer, size_t byteOffset, unsigned int instanceCount) const;
+
+    // lokalni AABB, racuna se pri ucitavanju
+    const Aabb& getLocalBounds() const { return m_bounds; }
+
+    // CPU kopija interleaved verteksa (za pecenje staticke geometrije)
+    const std::vector<float>& getVertexData() const { return m_vertices; }
+    unsigned int getVertexCount() const { return m_vertexCount; }
+    unsigned int getStrideFloats() const { return m_strideFloats; }
+
 private:
     void upload(const float* vertices, unsigned int vertexCount, unsigned int strideFloats);
 
@@ -22,4 +44,7 @@ private:
     unsigned int m_VBO = 0;
     unsigned int m_vertexCount = 0;
     unsigned int m_strideFloats = 0;
+
+    Aabb m_bounds;
+    std::vector<float> m_vertices;
 };
@@ -0,0 +1,71 @@
+#include "Name.h"
+
+#include <deque>
+#include <unordered_map>
+
+namespace
+{
+    struct NameTable
+    {
+        // deque ne pomera postojece elemente -> c_str() ostaje vazeci
+        std::deque<std::string> strings;
+        std::unordered_map<std::string, unsigned int> ids;
+
+        NameTable()
+        {
+            strings.push_back(std::string());
+            ids[std::string()] = 0;
+        }
+    };
+
+    NameTable& table()
+    {
+        static NameTable t;
+        return t;
+    }
+
+    unsigned int intern(const std::string& str)
+    {
+        NameTable& t = table();
+        auto it = t.ids.find(str);
+        if (it != t.ids.end()) return it->second;
+
+        unsigned int id = (unsigned int)t.strings.size();
+        t.strings.push_back(str);
+        t.ids.emplace(str, id);
+        return id;
+    }
+}
+
+Name::Name(const char* str)
+    : m_id(str ? intern(str) : 0)
+{
+}
+
+Name::Name(const std::string& str)
+    : m_id(intern(str))
+{
+}
+
+const char* Name::c_str() const
+{
+    return table().strings[m_id].c_str();
+}
+
+const std::string& Name::str() const
+{
+    return table().strings[m_id];
+}
+
+Name Name::find(const std::string& str)
+{
+    Name n;
+    auto it = table().ids.find(str);
+    if (it != table().ids.end()) n.m_id = it->second;
+    return n;
+}
+
+unsigned int Name::getInternedCount()
+{
+    return (unsigned int)table().strings.size();
+}
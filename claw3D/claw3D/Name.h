@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+
+// Internovano ime: svaki razlicit string se cuva jednom u globalnoj tabeli,
+// a objekti nose samo id. Poredjenje i hesiranje su poredjenje celih brojeva.
+class Name
+{
+public:
+    Name() = default;               // prazno ime (id 0)
+    Name(const char* str);
+    Name(const std::string& str);
+
+    const char* c_str() const;
+    const std::string& str() const;
+    unsigned int id() const { return m_id; }
+    bool empty() const { return m_id == 0; }
+
+    bool operator==(const Name& o) const { return m_id == o.m_id; }
+    bool operator!=(const Name& o) const { return m_id != o.m_id; }
+
+    // samo trazi, ne dodaje u tabelu; prazno ime ako string nikad nije internovan
+    static Name find(const std::string& str);
+    static unsigned int getInternedCount();
+
+private:
+    unsigned int m_id = 0;
+};
+
+struct NameHash
+{
+    size_t operator()(const Name& n) const { return n.id(); }
+};
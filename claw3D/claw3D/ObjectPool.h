@@ -0,0 +1,165 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+// Stabilna rucka na objekat u ObjectPool-u; generacija raste kad se slot oslobodi,
+// pa rucka na unisten objekat vise ne razresava (get vraca nullptr).
+struct PoolHandle
+{
+    unsigned int index = ~0u;
+    unsigned int generation = 0;
+
+    bool isNull() const { return index == ~0u; }
+    bool operator==(const PoolHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const PoolHandle& o) const { return !(*this == o); }
+};
+
+// Slab alokator: objekti u blokovima od SlabSize, slobodni slotovi u LIFO listi (O(1) create/destroy).
+// Blokovi se nikad ne pomeraju -> pokazivaci na objekte ostaju vazeci do destroy/reset.
+// Zivi slotovi se vode i u gustoj listi, pa forEach kosta srazmerno broju zivih objekata.
+// reset() unistava sve objekte ali zadrzava memoriju za sledecu scenu; trim() vraca prazne blokove sa kraja.
+template <typename T, unsigned int SlabSize = 64>
+class ObjectPool
+{
+public:
+    ObjectPool() = default;
+    ~ObjectPool() { reset(); }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    PoolHandle create(Args&&... args)
+    {
+        if (m_free.empty()) addSlab();
+
+        const unsigned int index = m_free.back();
+        m_free.pop_back();
+
+        new (slot(index)) T(std::forward<Args>(args)...);
+        m_live[index] = 1;
+        m_denseIndex[index] = (unsigned int)m_dense.size();
+        m_dense.push_back(index);
+
+        PoolHandle h;
+        h.index = index;
+        h.generation = m_generation[index];
+        return h;
+    }
+
+    void destroy(PoolHandle h)
+    {
+        if (!get(h)) return;
+
+        slot(h.index)->~T();
+        m_live[h.index] = 0;
+        m_generation[h.index]++;
+        m_free.push_back(h.index);
+
+        const unsigned int d = m_denseIndex[h.index];
+        m_dense[d] = m_dense.back();
+        m_denseIndex[m_dense[d]] = d;
+        m_dense.pop_back();
+    }
+
+    T* get(PoolHandle h) const
+    {
+        if (h.index >= m_live.size() || !m_live[h.index] || m_generation[h.index] != h.generation)
+            return nullptr;
+        return slot(h.index);
+    }
+
+    void reset()
+    {
+        for (unsigned int i : m_dense)
+        {
+            slot(i)->~T();
+            m_live[i] = 0;
+            m_generation[i]++;
+        }
+        m_dense.clear();
+
+        rebuildFreeList();
+    }
+
+    // oslobadja prazne blokove sa kraja; vraca broj oslobodjenih blokova.
+    // Generacije se cuvaju, pa stare rucke ni posle ponovnog rasta ne razresavaju.
+    unsigned int trim()
+    {
+        unsigned int released = 0;
+        while (!m_slabs.empty())
+        {
+            const unsigned int first = (unsigned int)(m_slabs.size() - 1) * SlabSize;
+            bool empty = true;
+            for (unsigned int i = first; i < first + SlabSize && empty; i++)
+                empty = !m_live[i];
+            if (!empty) break;
+
+            m_slabs.pop_back();
+            m_live.resize(first);
+            m_denseIndex.resize(first);
+            released++;
+        }
+
+        if (released) rebuildFreeList();
+        return released;
+    }
+
+    // f(T&) za svaki zivi objekat (redosled se menja posle destroy)
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        for (unsigned int i : m_dense)
+            f(*slot(i));
+    }
+
+    unsigned int size() const { return (unsigned int)m_dense.size(); }
+    unsigned int capacity() const { return (unsigned int)m_live.size(); }
+    unsigned int getSlabCount() const { return (unsigned int)m_slabs.size(); }
+
+private:
+    struct Slab
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type items[SlabSize];
+    };
+
+    T* slot(unsigned int index) const
+    {
+        return reinterpret_cast<T*>(&m_slabs[index / SlabSize]->items[index % SlabSize]);
+    }
+
+    void addSlab()
+    {
+        const unsigned int first = (unsigned int)m_live.size();
+        m_slabs.emplace_back(new Slab);
+        m_live.resize(first + SlabSize, 0);
+        m_denseIndex.resize(first + SlabSize, 0);
+        if (m_generation.size() < first + SlabSize)
+            m_generation.resize(first + SlabSize, 0);
+
+        for (unsigned int i = first + SlabSize; i-- > first;)
+            m_free.push_back(i);
+    }
+
+    // slobodni slotovi u rastucem redosledu (LIFO uzima najmanji indeks prvi)
+    void rebuildFreeList()
+    {
+        m_free.clear();
+        for (unsigned int i = (unsigned int)m_live.size(); i-- > 0;)
+        {
+            if (!m_live[i]) m_free.push_back(i);
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<Slab>> m_slabs;
+    std::vector<unsigned char> m_live;
+    std::vector<unsigned int> m_generation;     // nikad se ne smanjuje (vidi trim)
+    std::vector<unsigned int> m_free;
+
+    std::vector<unsigned int> m_dense;          // indeksi zivih slotova
+    std::vector<unsigned int> m_denseIndex;     // slot -> pozicija u m_dense
+};
@@ -0,0 +1,251 @@
+#include "OcclusionCuller.h"
+#include "Simd.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const float kMinW = 1e-4f;
+    const int kTilesX = OcclusionCuller::kWidth / OcclusionCuller::kTileSize;
+    const int kTilesY = OcclusionCuller::kHeight / OcclusionCuller::kTileSize;
+
+    // temena kutije: bit0 = x, bit1 = y, bit2 = z
+    const int kBoxTriangles[36] = {
+        0, 2, 6,  0, 6, 4,   // -x
+        1, 5, 7,  1, 7, 3,   // +x
+        0, 4, 5,  0, 5, 1,   // -y
+        2, 3, 7,  2, 7, 6,   // +y
+        0, 1, 3,  0, 3, 2,   // -z
+        4, 6, 7,  4, 7, 5,   // +z
+    };
+
+    glm::vec3 boxCorner(const Aabb& b, int i)
+    {
+        return { (i & 1) ? b.max.x : b.min.x, (i & 2) ? b.max.y : b.min.y, (i & 4) ? b.max.z : b.min.z };
+    }
+}
+
+OcclusionCuller::OcclusionCuller(unsigned int bandCount)
+    : m_depth(kWidth * kHeight, 1.0f), m_tileMax(kTilesX * kTilesY, 1.0f)
+{
+    if (bandCount == 0)
+        bandCount = JobSystem::instance().getThreadCount();
+
+    m_bandCount = std::min(bandCount, (unsigned int)kTilesY);
+}
+
+void OcclusionCuller::begin(const glm::mat4& viewProj)
+{
+    m_viewProj = viewProj;
+    m_triangles.clear();
+    std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+    std::fill(m_tileMax.begin(), m_tileMax.end(), 1.0f);
+}
+
+void OcclusionCuller::addOccluder(const Aabb& localBox, const glm::mat4& model)
+{
+    if (!localBox.valid()) return;
+
+    const glm::mat4 mvp = m_viewProj * model;
+
+    ScreenVertex corners[8];
+    for (int i = 0; i < 8; i++)
+    {
+        glm::vec4 clip = mvp * glm::vec4(boxCorner(localBox, i), 1.0f);
+
+        // kutija sece near ravan -> bez kliping-a je samo preskacemo (konzervativno)
+        if (clip.w < kMinW) return;
+
+        float invW = 1.0f / clip.w;
+        corners[i].x = (clip.x * invW * 0.5f + 0.5f) * kWidth;
+        corners[i].y = (clip.y * invW * 0.5f + 0.5f) * kHeight;
+        corners[i].z = clip.z * invW * 0.5f + 0.5f;
+    }
+
+    for (int i = 0; i < 36; i++)
+        m_triangles.push_back(corners[kBoxTriangles[i]]);
+}
+
+void OcclusionCuller::rasterize()
+{
+    // trake pisu disjunktne redove bafera
+    JobSystem::instance().parallelFor(m_bandCount, 1,
+        [this](unsigned int begin, unsigned int end)
+        {
+            for (unsigned int band = begin; band < end; band++)
+                rasterizeBand(band);
+        });
+}
+
+void OcclusionCuller::rasterizeBand(unsigned int band)
+{
+    // trake su poravnate na redove plocica
+    int tileRowBegin = (int)(band * kTilesY / m_bandCount);
+    int tileRowEnd = (int)((band + 1) * kTilesY / m_bandCount);
+    int rowBegin = tileRowBegin * kTileSize;
+    int rowEnd = tileRowEnd * kTileSize;
+
+    for (size_t i = 0; i + 2 < m_triangles.size(); i += 3)
+        rasterizeTriangle(m_triangles[i], m_triangles[i + 1], m_triangles[i + 2], rowBegin, rowEnd);
+
+    for (int ty = tileRowBegin; ty < tileRowEnd; ty++)
+    {
+        for (int tx = 0; tx < kTilesX; tx++)
+        {
+            float maxZ = 0.0f;
+            for (int y = ty * kTileSize; y < (ty + 1) * kTileSize; y++)
+            {
+                const float* row = &m_depth[y * kWidth + tx * kTileSize];
+                for (int x = 0; x < kTileSize; x++)
+                    maxZ = std::max(maxZ, row[x]);
+            }
+            m_tileMax[ty * kTilesX + tx] = maxZ;
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeTriangle(const ScreenVertex& a, const ScreenVertex& b0, const ScreenVertex& c0,
+    int rowBegin, int rowEnd)
+{
+    float area = (b0.x - a.x) * (c0.y - a.y) - (c0.x - a.x) * (b0.y - a.y);
+    if (std::fabs(area) < 1e-8f) return;
+
+    // orijentacija nije bitna (kutija se crta sa obe strane): svedi na area > 0
+    const ScreenVertex& b = area > 0.0f ? b0 : c0;
+    const ScreenVertex& c = area > 0.0f ? c0 : b0;
+    area = std::fabs(area);
+
+    int minX = std::max(0, (int)std::floor(std::min(a.x, std::min(b.x, c.x))));
+    int maxX = std::min(kWidth - 1, (int)std::ceil(std::max(a.x, std::max(b.x, c.x))));
+    int minY = std::max(rowBegin, (int)std::floor(std::min(a.y, std::min(b.y, c.y))));
+    int maxY = std::min(rowEnd - 1, (int)std::ceil(std::max(a.y, std::max(b.y, c.y))));
+    if (minX > maxX || minY > maxY) return;
+
+    // ivicne funkcije E_uv(p) = (v - u) x (p - u) = A*x + B*y + C, unutra >= 0
+    const float A0 = a.y - b.y, B0 = b.x - a.x, C0 = (b.y - a.y) * a.x - (b.x - a.x) * a.y;
+    const float A1 = b.y - c.y, B1 = c.x - b.x, C1 = (c.y - b.y) * b.x - (c.x - b.x) * b.y;
+    const float A2 = c.y - a.y, B2 = a.x - c.x, C2 = (a.y - c.y) * c.x - (a.x - c.x) * c.y;
+
+    // ravan dubine z = a.z + dzdx*(x - a.x) + dzdy*(y - a.y)
+    const float dzdx = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+    const float dzdy = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+    const float z0 = a.z - dzdx * a.x - dzdy * a.y;
+
+    const int startX = minX & ~3;
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        const float py = (float)y + 0.5f;
+        float* row = &m_depth[y * kWidth];
+
+#if CLAW_SIMD_SSE
+        const __m128 lane = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 vMinX = _mm_set1_ps((float)minX);
+        const __m128 vMaxX = _mm_set1_ps((float)maxX + 1.0f);
+        const __m128 zero = _mm_setzero_ps();
+
+        for (int x = startX; x <= maxX; x += 4)
+        {
+            __m128 px = _mm_add_ps(_mm_set1_ps((float)x), lane);
+
+            __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A0), px), _mm_set1_ps(B0 * py + C0));
+            __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A1), px), _mm_set1_ps(B1 * py + C1));
+            __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A2), px), _mm_set1_ps(B2 * py + C2));
+
+            __m128 mask = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(e2, zero));
+            mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(px, vMinX), _mm_cmplt_ps(px, vMaxX)));
+
+            if (_mm_movemask_ps(mask) == 0) continue;
+
+            __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(dzdx), px), _mm_set1_ps(dzdy * py + z0));
+            __m128 old = _mm_loadu_ps(row + x);
+            __m128 nearer = _mm_min_ps(old, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(mask, nearer), _mm_andnot_ps(mask, old)));
+        }
+#else
+        for (int x = minX; x <= maxX; x++)
+        {
+            const float px = (float)x + 0.5f;
+            if (A0 * px + B0 * py + C0 < 0.0f) continue;
+            if (A1 * px + B1 * py + C1 < 0.0f) continue;
+            if (A2 * px + B2 * py + C2 < 0.0f) continue;
+
+            float z = dzdx * px + dzdy * py + z0;
+            if (z < row[x]) row[x] = z;
+        }
+        (void)startX;
+#endif
+    }
+}
+
+bool OcclusionCuller::isVisible(const Aabb& worldBox) const
+{
+    if (!worldBox.valid()) return true;
+
+    float minSX = 1e30f, minSY = 1e30f, maxSX = -1e30f, maxSY = -1e30f;
+    float minZ = 1.0f;
+
+    for (int i = 0; i < 8; i++)
+    {
+        glm::vec4 clip = m_viewProj * glm::vec4(boxCorner(worldBox, i), 1.0f);
+        if (clip.w < kMinW) return true;   // sece near ravan
+
+        float invW = 1.0f / clip.w;
+        float sx = (clip.x * invW * 0.5f + 0.5f) * kWidth;
+        float sy = (clip.y * invW * 0.5f + 0.5f) * kHeight;
+        float sz = clip.z * invW * 0.5f + 0.5f;
+
+        minSX = std::min(minSX, sx); maxSX = std::max(maxSX, sx);
+        minSY = std::min(minSY, sy); maxSY = std::max(maxSY, sy);
+        minZ = std::min(minZ, sz);
+    }
+
+    // pravougaonik se siri za piksel (okluder je uzorkovan u centrima piksela)
+    int x0 = std::max(0, (int)std::floor(minSX) - 1);
+    int x1 = std::min(kWidth - 1, (int)std::ceil(maxSX) + 1);
+    int y0 = std::max(0, (int)std::floor(minSY) - 1);
+    int y1 = std::min(kHeight - 1, (int)std::ceil(maxSY) + 1);
+    if (x0 > x1 || y0 > y1) return true;
+
+    for (int ty = y0 / kTileSize; ty <= y1 / kTileSize; ty++)
+    {
+        for (int tx = x0 / kTileSize; tx <= x1 / kTileSize; tx++)
+        {
+            // cela plocica je bliza od objekta -> nista ne proviruje
+            if (m_tileMax[ty * kTilesX + tx] < minZ) continue;
+
+            int rx0 = std::max(x0, tx * kTileSize);
+            int rx1 = std::min(x1, tx * kTileSize + kTileSize - 1);
+            int ry0 = std::max(y0, ty * kTileSize);
+            int ry1 = std::min(y1, ty * kTileSize + kTileSize - 1);
+
+            for (int y = ry0; y <= ry1; y++)
+            {
+                const float* row = &m_depth[y * kWidth];
+#if CLAW_SIMD_SSE
+                const __m128 vz = _mm_set1_ps(minZ);
+                int x = rx0;
+                for (; x + 4 <= rx1 + 1; x += 4)
+                {
+                    if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), vz)) != 0)
+                        return true;
+                }
+                for (; x <= rx1; x++)
+                {
+                    if (row[x] >= minZ) return true;
+                }
+#else
+                for (int x = rx0; x <= rx1; x++)
+                {
+                    if (row[x] >= minZ) return true;
+                }
+#endif
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+// Softverski occlusion culling na CPU-u (bez GL-a, moze da radi headless).
+// Okluderi (kutije) se rasterizuju u 256x128 depth bafer, 4 piksela po SIMD koraku,
+// u horizontalnim trakama paralelno (poslovi u JobSystem-u). Za svaku 8x8 plocicu se cuva
+// najdalja dubina, pa vecina testova okludiranih objekata ne mora do piksela.
+class OcclusionCuller
+{
+public:
+    static const int kWidth = 256;
+    static const int kHeight = 128;
+    static const int kTileSize = 8;
+
+    explicit OcclusionCuller(unsigned int bandCount = 0);   // 0 = broj niti JobSystem-a
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    // pocetak frejma: brise bafer i listu okludera
+    void begin(const glm::mat4& viewProj);
+
+    // kutija localBox transformisana model matricom (12 trouglova)
+    void addOccluder(const Aabb& localBox, const glm::mat4& model);
+
+    // rasterizuje sve okludere; blokira dok sve trake ne zavrse
+    void rasterize();
+
+    // false samo ako je svetski AABB sigurno iza okludera
+    bool isVisible(const Aabb& worldBox) const;
+
+    const float* getDepthBuffer() const { return m_depth.data(); }
+    unsigned int getTriangleCount() const { return (unsigned int)(m_triangles.size() / 3); }
+
+private:
+    struct ScreenVertex { float x, y, z; };
+
+    void rasterizeBand(unsigned int band);
+    void rasterizeTriangle(const ScreenVertex& a, const ScreenVertex& b, const ScreenVertex& c, int rowBegin, int rowEnd);
+
+private:
+    glm::mat4 m_viewProj{ 1.0f };
+
+    std::vector<float> m_depth;         // kWidth * kHeight, 0 = near, 1 = far
+    std::vector<float> m_tileMax;       // najdalja dubina po plocici
+    std::vector<ScreenVertex> m_triangles;
+
+    unsigned int m_bandCount = 1;
+};
@@ -0,0 +1,125 @@
+#include "OitPass.h"
+#include "Shader.h"
+#include "GLState.h"
+
+#include <glad/glad.h>
+#include <iostream>
+
+OitPass::OitPass() = default;
+
+OitPass::~OitPass()
+{
+    release();
+}
+
+void OitPass::release()
+{
+    if (m_accumTexture) { glDeleteTextures(1, &m_accumTexture); GLState::onTextureDeleted(m_accumTexture); }
+    if (m_weightTexture) { glDeleteTextures(1, &m_weightTexture); GLState::onTextureDeleted(m_weightTexture); }
+    if (m_depthRBO) glDeleteRenderbuffers(1, &m_depthRBO);
+    if (m_FBO) { glDeleteFramebuffers(1, &m_FBO); GLState::onFramebufferDeleted(m_FBO); }
+    if (m_resolveVAO) { glDeleteVertexArrays(1, &m_resolveVAO); GLState::onVertexArrayDeleted(m_resolveVAO); }
+
+    m_accumTexture = m_weightTexture = m_depthRBO = m_FBO = m_resolveVAO = 0;
+
+    delete m_resolveShader;
+    m_resolveShader = nullptr;
+}
+
+static unsigned int createTarget(int width, int height, GLenum internalFormat, GLenum format)
+{
+    unsigned int tex;
+    glGenTextures(1, &tex);
+    GLState::bindTexture2D(0, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return tex;
+}
+
+bool OitPass::init(int width, int height)
+{
+    release();
+
+    m_width = width;
+    m_height = height;
+
+    m_accumTexture = createTarget(width, height, GL_RGBA16F, GL_RGBA);
+    m_weightTexture = createTarget(width, height, GL_R16F, GL_RED);
+
+    // isti format kao default depth (GLFW: 24 + 8) da bi blit dubine bio dozvoljen
+    glGenRenderbuffers(1, &m_depthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_accumTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_weightTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRBO);
+
+    const GLenum buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, buffers);
+
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, GLState::getDefaultFramebuffer());
+
+    if (!complete)
+    {
+        std::cerr << "OIT framebuffer incomplete\n";
+        release();
+        return false;
+    }
+
+    glGenVertexArrays(1, &m_resolveVAO);
+
+    m_resolveShader = new Shader("shaders/oit_resolve.vert", "shaders/oit_resolve.frag");
+    m_resolveShader->use();
+    m_resolveShader->setInt("u_Accum", 0);
+    m_resolveShader->setInt("u_Weight", 1);
+
+    return true;
+}
+
+void OitPass::begin()
+{
+    // dubina neprovidnog prolaza -> OIT framebuffer
+    GLState::bindFramebuffer(GL_READ_FRAMEBUFFER, GLState::getDefaultFramebuffer());
+    GLState::bindFramebuffer(GL_DRAW_FRAMEBUFFER, m_FBO);
+    glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+
+    const float clearAccum[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    const float clearWeight[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    glClearBufferfv(GL_COLOR, 0, clearAccum);
+    glClearBufferfv(GL_COLOR, 1, clearWeight);
+
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::depthMask(false);
+
+    GLState::enable(GL_BLEND);
+    GLState::blendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void OitPass::resolve()
+{
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, GLState::getDefaultFramebuffer());
+
+    GLState::depthMask(true);
+    GLState::disable(GL_DEPTH_TEST);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    m_resolveShader->use();
+
+    GLState::bindTexture2D(0, m_accumTexture);
+    GLState::bindTexture2D(1, m_weightTexture);
+
+    GLState::bindVertexArray(m_resolveVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    GLState::disable(GL_BLEND);
+    GLState::enable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+class Shader;
+
+// Weighted blended order-independent transparency.
+// begin() preusmerava crtanje u accum/weight targete (dubina se kopira iz default framebuffer-a,
+// test ukljucen, upis iskljucen); resolve() ih kompozitira preko neprovidne slike.
+class OitPass
+{
+public:
+    OitPass();
+    ~OitPass();
+
+    bool init(int width, int height);
+
+    void begin();
+    void resolve();
+
+    bool isReady() const { return m_FBO != 0; }
+
+private:
+    void release();
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+
+    unsigned int m_FBO = 0;
+    unsigned int m_accumTexture = 0;    // RGBA16F: sum(C*a*w), alpha = revealage
+    unsigned int m_weightTexture = 0;   // R16F: sum(a*w)
+    unsigned int m_depthRBO = 0;
+
+    unsigned int m_resolveVAO = 0;
+    Shader* m_resolveShader = nullptr;
+};
@@ -0,0 +1,65 @@
+#include "Prefab.h"
+#include "Scene.h"
+#include "Mesh.h"
+#include "GameObject.h"
+#include "Util.h"
+#include "GLState.h"
+
+#include <iostream>
+
+Prefab::~Prefab()
+{
+    for (Mesh* mesh : m_ownedMeshes) delete mesh;
+
+    for (unsigned int texture : m_textures)
+    {
+        if (!texture) continue;
+        glDeleteTextures(1, &texture);
+        GLState::onTextureDeleted(texture);
+    }
+}
+
+bool Prefab::load(const std::string& path, Mesh* cube, Mesh* sphere)
+{
+    if (!m_file.open(path))
+    {
+        // binarni fajl fali ili je stare verzije -> prevodi se iz tekstualnog oblika
+        std::string textPath = path.substr(0, path.find_last_of('.')) + ".txt";
+        std::string error;
+        if (!compileSceneText(textPath, path, error) || !m_file.open(path))
+        {
+            std::cerr << "Prefab load failed: " << error << "\n";
+            return false;
+        }
+    }
+
+    m_meshes.resize(m_file.getMeshCount());
+    for (unsigned int i = 0; i < m_file.getMeshCount(); i++)
+    {
+        const std::string meshPath = m_file.getMeshPath(i);
+        if (meshPath == "builtin:cube") m_meshes[i] = cube;
+        else if (meshPath == "builtin:sphere") m_meshes[i] = sphere;
+        else
+        {
+            m_meshes[i] = new Mesh(meshPath);
+            m_ownedMeshes.push_back(m_meshes[i]);
+        }
+    }
+
+    m_textures.resize(m_file.getTextureCount());
+    for (unsigned int i = 0; i < m_file.getTextureCount(); i++)
+        m_textures[i] = loadImageToTexture(m_file.getTexturePath(i));
+
+    return true;
+}
+
+GameObject* Prefab::instantiate(Scene& scene, const glm::vec3& position, float yawDegrees,
+    std::vector<GameObject*>* created) const
+{
+    GameObject* root = scene.createObject(nullptr, "PrefabRoot");
+    root->transform.setPosition(position);
+    root->transform.setRotation({ 0.0f, yawDegrees, 0.0f });
+
+    scene.instantiate(m_file, m_meshes, m_textures, root, created);
+    return root;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "SceneFile.h"
+
+class Scene;
+class Mesh;
+class GameObject;
+
+// Nepromenljiv opis hijerarhije (mapiran .scn) + resursi razreseni jednom (mesh-evi, teksture).
+// Svaka instanca pravi samo svoje GameObject-e ispod novog root cvora; mesh-evi, materijali i
+// stringovi (internovana imena) se dele izmedju svih instanci.
+class Prefab
+{
+public:
+    Prefab() = default;
+    ~Prefab();
+
+    Prefab(const Prefab&) = delete;
+    Prefab& operator=(const Prefab&) = delete;
+
+    // mapira .scn (ako fali ili je stare verzije, prevodi ga iz .txt pored njega) i ucitava
+    // resurse; "builtin:cube" / "builtin:sphere" su proceduralni mesh-evi pozivaoca
+    bool load(const std::string& path, Mesh* cube, Mesh* sphere);
+
+    // root = prazan cvor na position, okrenut za yawDegrees oko Y; created (opciono) dobija
+    // objekte instance u redosledu iz fajla
+    GameObject* instantiate(Scene& scene, const glm::vec3& position, float yawDegrees,
+        std::vector<GameObject*>* created = nullptr) const;
+
+    bool isLoaded() const { return m_file.isOpen(); }
+    unsigned int getObjectCount() const { return m_file.isOpen() ? m_file.getObjectCount() : 0; }
+
+private:
+    SceneFile m_file;
+    std::vector<Mesh*> m_meshes;        // po indeksu iz fajla
+    std::vector<Mesh*> m_ownedMeshes;   // OBJ mesh-evi koje je Prefab ucitao
+    std::vector<unsigned int> m_textures;
+};
@@ -0,0 +1,125 @@
+#include "Profiler.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    // ThreadBuffer tekuce niti: pravi se pri prvoj snimljenoj zoni, pa nit koja nikad ne snima
+    // (npr. bez --profile) ne placa prsten; ime se pamti odmah i prelazi u bafer kad nastane
+    thread_local void* t_buffer = nullptr;
+    thread_local std::string t_threadName;
+
+    // zone koje su prosle proveru pre setEnabled(false) jos mogu da se upisu tokom izvoza;
+    // izvoz zato preskace najstarijih kSlack mesta u punom baferu, gde bi pisale
+    const uint32_t kSlack = 256;
+
+    const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+    void writeEscaped(std::ostream& out, const char* s)
+    {
+        for (; *s; s++)
+        {
+            if (*s == '"' || *s == '\\') out << '\\';
+            out << *s;
+        }
+    }
+}
+
+const uint32_t Profiler::kCapacity;
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer()
+{
+    if (!t_buffer)
+    {
+        std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+        buffer->zones.resize(kCapacity);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        buffer->id = (uint32_t)m_threads.size() + 1;
+        buffer->name = t_threadName.empty() ? "thread " + std::to_string(buffer->id) : t_threadName;
+        t_buffer = buffer.get();
+        m_threads.push_back(std::move(buffer));
+    }
+    return *static_cast<ThreadBuffer*>(t_buffer);
+}
+
+void Profiler::setThreadName(const std::string& name)
+{
+    t_threadName = name;
+    if (!t_buffer) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    static_cast<ThreadBuffer*>(t_buffer)->name = name;
+}
+
+void Profiler::record(const char* name, uint64_t begin, uint64_t end)
+{
+    ThreadBuffer& buffer = threadBuffer();
+
+    // zona pa head (release): izvoz vidi samo zavrsene upise
+    const uint32_t head = buffer.head.load(std::memory_order_relaxed);
+    Zone& zone = buffer.zones[head % kCapacity];
+    zone.name = name;
+    zone.begin = begin;
+    zone.end = end;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path)
+{
+    setEnabled(false);
+
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Cannot write profile " << path << "\n";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // "X" = kompletan dogadjaj (pocetak + trajanje), vremena u mikrosekundama
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    size_t written = 0;
+    for (const auto& buffer : m_threads)
+    {
+        out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+            << ",\"args\":{\"name\":\"";
+        writeEscaped(out, buffer->name.c_str());
+        out << "\"}}";
+        first = false;
+
+        const uint32_t head = buffer->head.load(std::memory_order_acquire);
+        const uint32_t count = head < kCapacity ? head : kCapacity - kSlack;
+        for (uint32_t i = head - count; i != head; i++)
+        {
+            const Zone& zone = buffer->zones[i % kCapacity];
+            out << ",\n{\"name\":\"";
+            writeEscaped(out, zone.name);
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"ts\":" << (double)zone.begin * 1e-3 << ",\"dur\":" << (double)(zone.end - zone.begin) * 1e-3 << "}";
+        }
+        written += count;
+    }
+    out << "\n]}\n";
+
+    std::cout << "Profile: " << written << " zona, " << m_threads.size() << " niti -> " << path << "\n";
+    return (bool)out;
+}
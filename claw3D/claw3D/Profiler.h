@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// CLAW_PROFILE=0 (npr. /D CLAW_PROFILE=0 za release-min build) prevodi PROFILE_* makroe u nista;
+// klasa ostaje, ali bez zona nema sta da snimi
+#ifndef CLAW_PROFILE
+#define CLAW_PROFILE 1
+#endif
+
+// CPU profajler sa zonama: PROFILE_ZONE("Scene::update") meri opseg do kraja bloka.
+// Svaka nit pise u svoj prstenasti bafer (bez lock-a; mutex samo kad se nit prvi put javi),
+// pa bafer uvek drzi poslednjih kCapacity zona te niti. Snimak se izvozi kao Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev). Ime zone mora da zivi do izvoza (string literal).
+class Profiler
+{
+public:
+    static const uint32_t kCapacity = 1u << 16;     // zona po niti
+
+    static Profiler& instance();
+
+    // snimanje u toku rada; iskljuceno: zona kosta jedno citanje atomica
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // ime tekuce niti u trace-u ("main", "render", "worker 3"); ne alocira bafer
+    void setThreadName(const std::string& name);
+
+    // ns od pocetka rada (steady_clock)
+    static uint64_t now();
+
+    // poziva se iz ~ProfileScope (samo kad je snimanje bilo ukljuceno), za nit pozivaoca;
+    // prvi poziv na niti alocira njen prsten
+    void record(const char* name, uint64_t begin, uint64_t end);
+
+    // zaustavlja snimanje i upisuje sve bafere; false ako fajl ne moze da se otvori
+    bool writeChromeTrace(const std::string& path);
+
+private:
+    struct Zone
+    {
+        const char* name;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    struct ThreadBuffer
+    {
+        std::string name;
+        uint32_t id = 0;
+        std::vector<Zone> zones;            // kCapacity, prstenasto
+        std::atomic<uint32_t> head{ 0 };    // ukupno upisanih; pise samo vlasnik
+    };
+
+    ThreadBuffer& threadBuffer();
+
+private:
+    std::atomic<bool> m_enabled{ false };
+
+    std::mutex m_mutex;                     // samo registracija niti i izvoz
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+        : m_name(Profiler::instance().isEnabled() ? name : nullptr), m_begin(m_name ? Profiler::now() : 0)
+    {
+    }
+
+    ~ProfileScope()
+    {
+        if (m_name) Profiler::instance().record(m_name, m_begin, Profiler::now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_begin;
+};
+
+#define CLAW_PROFILE_CONCAT_(a, b) a##b
+#define CLAW_PROFILE_CONCAT(a, b) CLAW_PROFILE_CONCAT_(a, b)
+
+#if CLAW_PROFILE
+#define PROFILE_ZONE(name) ProfileScope CLAW_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::instance().setThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
@@ -0,0 +1,220 @@
+#include "Scenario.h"
+#include "Input.h"
+
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    // ime iz fajla -> Input kod; -1 ako ne postoji
+    int keyCode(const std::string& name)
+    {
+        if (name.size() == 1)
+        {
+            const char c = name[0];
+            if (c >= 'A' && c <= 'Z') return GLFW_KEY_A + (c - 'A');
+            if (c >= '0' && c <= '9') return GLFW_KEY_0 + (c - '0');
+            return -1;
+        }
+
+        if (name == "SPACE") return GLFW_KEY_SPACE;
+        if (name == "ESCAPE") return GLFW_KEY_ESCAPE;
+        if (name == "LEFT") return GLFW_KEY_LEFT;
+        if (name == "RIGHT") return GLFW_KEY_RIGHT;
+        if (name == "UP") return GLFW_KEY_UP;
+        if (name == "DOWN") return GLFW_KEY_DOWN;
+        if (name == "MOUSE_LEFT") return Input::kKeyCount + GLFW_MOUSE_BUTTON_LEFT;
+        if (name == "MOUSE_RIGHT") return Input::kKeyCount + GLFW_MOUSE_BUTTON_RIGHT;
+
+        if (name[0] == 'F')
+        {
+            const int n = std::atoi(name.c_str() + 1);
+            if (n >= 1 && n <= 12) return GLFW_KEY_F1 + (n - 1);
+        }
+        return -1;
+    }
+
+    float percentile(const std::vector<float>& sorted, float p)
+    {
+        const size_t i = std::min(sorted.size() - 1, (size_t)(p * (float)(sorted.size() - 1) + 0.5f));
+        return sorted[i];
+    }
+
+    template <typename F>
+    void writeTiming(std::ostream& out, const char* name, const std::vector<ScenarioSample>& samples, F field)
+    {
+        std::vector<float> sorted;
+        sorted.reserve(samples.size());
+        float sum = 0.0f;
+        for (const ScenarioSample& s : samples)
+        {
+            sorted.push_back(field(s));
+            sum += field(s);
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        out << "\"" << name << "\": { \"avg\": " << sum / (float)sorted.size()
+            << ", \"p50\": " << percentile(sorted, 0.50f) << ", \"p95\": " << percentile(sorted, 0.95f)
+            << ", \"p99\": " << percentile(sorted, 0.99f) << ", \"max\": " << sorted.back() << " }";
+    }
+
+    template <typename F>
+    void writeCounter(std::ostream& out, const char* name, const std::vector<ScenarioSample>& samples, F field)
+    {
+        unsigned long long total = 0;
+        unsigned int max = 0;
+        for (const ScenarioSample& s : samples)
+        {
+            total += field(s);
+            max = std::max(max, field(s));
+        }
+        out << "\"" << name << "\": { \"total\": " << total << ", \"max\": " << max << " }";
+    }
+
+    std::string escape(const std::string& s)
+    {
+        std::string out;
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+}
+
+bool Scenario::load(const std::string& path, std::string& error)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    m_path = path;
+    m_frames = 0;
+    m_warmup = 0;
+    m_events.clear();
+    m_next = 0;
+
+    int lineNo = 0;
+    auto fail = [&](const std::string& message)
+        {
+            error = path + ":" + std::to_string(lineNo) + ": " + message;
+            return false;
+        };
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        lineNo++;
+
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream ls(line);
+        std::string key;
+        if (!(ls >> key)) continue;
+
+        if (key == "frames")
+        {
+            if (!(ls >> m_frames) || m_frames == 0) return fail("frames expects a positive count");
+        }
+        else if (key == "warmup")
+        {
+            if (!(ls >> m_warmup)) return fail("warmup expects a count");
+        }
+        else if (key == "at")
+        {
+            unsigned int frame;
+            std::string action, name;
+            if (!(ls >> frame >> action >> name)) return fail("at expects <frame> down|up|tap <key>");
+
+            const int code = keyCode(name);
+            if (code < 0) return fail("unknown key '" + name + "'");
+
+            if (action != "down" && action != "up" && action != "tap") return fail("unknown action '" + action + "'");
+
+            if (action != "up") m_events.push_back({ frame, code, true });
+            if (action != "down") m_events.push_back({ frame, code, false });
+        }
+        else
+        {
+            return fail("unknown keyword '" + key + "'");
+        }
+    }
+
+    if (m_frames == 0) return fail("missing frames");
+    if (m_warmup >= m_frames) return fail("warmup must be shorter than frames");
+
+    std::stable_sort(m_events.begin(), m_events.end(),
+        [](const Event& a, const Event& b) { return a.frame < b.frame; });
+    return true;
+}
+
+void Scenario::apply(unsigned int frame, Input& input)
+{
+    while (m_next < m_events.size() && m_events[m_next].frame <= frame)
+    {
+        const Event& e = m_events[m_next++];
+        input.inject(e.code, e.down);
+    }
+}
+
+bool writeScenarioReport(const std::string& path, const Scenario& scenario, const ScenarioRunInfo& info,
+    const std::vector<ScenarioSample>& samples)
+{
+    if (samples.empty()) return false;
+
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Cannot write scenario report " << path << "\n";
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n"
+        << "  \"scenario\": \"" << escape(scenario.getPath()) << "\",\n"
+        << "  \"frames\": " << samples.size() << ",\n"
+        << "  \"warmup\": " << scenario.getWarmupFrames() << ",\n"
+        << "  \"run\": { \"renderer\": \"" << escape(info.renderer) << "\", \"width\": " << info.width
+        << ", \"height\": " << info.height << ", \"headless\": " << (info.headless ? "true" : "false")
+        << ", \"renderThread\": " << (info.renderThread ? "true" : "false") << ", \"cabinets\": " << info.cabinets
+        << ", \"simulationHz\": " << info.simulationHz << " },\n";
+
+    out << "  \"timingMs\": {\n    ";
+    writeTiming(out, "frame", samples, [](const ScenarioSample& s) { return s.frameMs; });
+    out << ",\n    ";
+    writeTiming(out, "update", samples, [](const ScenarioSample& s) { return s.updateMs; });
+    out << ",\n    ";
+    writeTiming(out, "cull", samples, [](const ScenarioSample& s) { return s.cullMs; });
+    out << ",\n    ";
+    writeTiming(out, "submit", samples, [](const ScenarioSample& s) { return s.submitMs; });
+    out << "\n  },\n";
+
+    // brojaci ne zavise od brzine masine: razlika ovde je promena u radu, ne sum merenja
+    out << "  \"counters\": {\n    ";
+    writeCounter(out, "drawCalls", samples, [](const ScenarioSample& s) { return s.drawCalls; });
+    out << ",\n    ";
+    writeCounter(out, "objectsDrawn", samples, [](const ScenarioSample& s) { return s.objectsDrawn; });
+    out << ",\n    ";
+    writeCounter(out, "objectsVisible", samples, [](const ScenarioSample& s) { return s.objectsVisible; });
+    out << ",\n    ";
+    writeCounter(out, "objectsCulled", samples, [](const ScenarioSample& s) { return s.objectsCulled; });
+    out << ",\n    ";
+    writeCounter(out, "objectsOccluded", samples, [](const ScenarioSample& s) { return s.objectsOccluded; });
+    out << ",\n    ";
+    writeCounter(out, "glCallsIssued", samples, [](const ScenarioSample& s) { return s.glCallsIssued; });
+    out << ",\n    ";
+    writeCounter(out, "glCallsElided", samples, [](const ScenarioSample& s) { return s.glCallsElided; });
+    out << "\n  }\n}\n";
+
+    return (bool)out;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <string>
+#include <vector>
+
+class Input;
+
+// Skriptovan ulaz za ponovljiva merenja (--scenario scenarios/x.txt). Vremenska osa je u
+// frejmovima, ne u sekundama: u ovom rezimu svaki frejm je tacno jedan korak simulacije,
+// pa isti fajl uvek daje isto kretanje kamere i kandze, bez obzira na brzinu masine.
+//
+//   frames <N>                     ukupno frejmova
+//   warmup <N>                     prvih N frejmova se ne meri (ucitavanje, prvi upload-i)
+//   at <frejm> down|up|tap <taster>
+//
+// Tasteri: A-Z, 0-9, SPACE, ESCAPE, LEFT, RIGHT, UP, DOWN, F1-F12, MOUSE_LEFT, MOUSE_RIGHT.
+// tap = pritisnut i pusten u istom frejmu (wasPressed/wasClicked, isDown ne vidi nista).
+class Scenario
+{
+public:
+    struct Event
+    {
+        unsigned int frame;
+        int code;           // Input kod (tasteri misa posle tastature)
+        bool down;
+    };
+
+    // false + error (sa brojem linije) ako fajl ne valja
+    bool load(const std::string& path, std::string& error);
+
+    const std::string& getPath() const { return m_path; }
+    unsigned int getFrameCount() const { return m_frames; }
+    unsigned int getWarmupFrames() const { return m_warmup; }
+
+    // salje dogadjaje zakazane za frame; poziva se pre koraka simulacije tog frejma
+    void apply(unsigned int frame, Input& input);
+
+private:
+    std::string m_path;
+    unsigned int m_frames = 0;
+    unsigned int m_warmup = 0;
+
+    std::vector<Event> m_events;        // sortirano po frejmu (stabilno: redosled iz fajla)
+    size_t m_next = 0;
+};
+
+// jedan izmeren frejm; vremena na CPU (submit je GL strana, bez swapBuffers)
+struct ScenarioSample
+{
+    float frameMs = 0.0f;
+    float updateMs = 0.0f;      // koraci simulacije + Scene::update
+    float cullMs = 0.0f;        // buildFrame: frustum + occlusion culling i pravljenje paketa
+    float submitMs = 0.0f;
+
+    unsigned int drawCalls = 0;
+    unsigned int objectsDrawn = 0;
+    unsigned int objectsVisible = 0;
+    unsigned int objectsCulled = 0;
+    unsigned int objectsOccluded = 0;
+    unsigned int glCallsIssued = 0;
+    unsigned int glCallsElided = 0;
+};
+
+// opis pokretanja koji ide u zaglavlje izvestaja (poredi se samo isto sa istim)
+struct ScenarioRunInfo
+{
+    std::string renderer;
+    int width = 0;
+    int height = 0;
+    bool headless = false;
+    bool renderThread = false;
+    unsigned int cabinets = 0;
+    unsigned int simulationHz = 0;
+};
+
+// JSON izvestaj: percentili vremena (p50/p95/p99/max) i zbirovi brojaca u fajl path
+bool writeScenarioReport(const std::string& path, const Scenario& scenario, const ScenarioRunInfo& info,
+    const std::vector<ScenarioSample>& samples);
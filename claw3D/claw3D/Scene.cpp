@@ -1,43 +1,527 @@
 #include "Scene.h"
 #include "GameObject.h"
-#include "Shader.h"
 #include "Camera.h"
+#include "Frustum.h"
+#include "OcclusionCuller.h"
+#include "TransformSystem.h"
+#include "Components.h"
+#include "SceneFile.h"
+#include "Profiler.h"
 
-//#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
 
-GameObject* Scene::createObject(Mesh* mesh, const std::string& name)
+Scene::Scene() = default;
+
+Scene::~Scene()
+{
+    clear();
+}
+
+namespace
+{
+    const std::vector<GameObject*>& lookup(const std::unordered_map<Name, std::vector<GameObject*>, NameHash>& index, const Name& key)
+    {
+        static const std::vector<GameObject*> none;
+        auto it = index.find(key);
+        return it != index.end() ? it->second : none;
+    }
+
+    // vraca mesto objekta u kofi (objekat ga pamti za unindex)
+    unsigned int addToIndex(std::unordered_map<Name, std::vector<GameObject*>, NameHash>& index, const Name& key, GameObject* obj)
+    {
+        std::vector<GameObject*>& bucket = index[key];
+        bucket.push_back(obj);
+        return (unsigned int)bucket.size() - 1;
+    }
+
+    // O(1): poslednji objekat kofe prelazi na oslobodjeno mesto; slotOf(obj) je njegov zapamceni indeks
+    template <typename SlotOf>
+    void unindex(std::unordered_map<Name, std::vector<GameObject*>, NameHash>& index, const Name& key, unsigned int slot, SlotOf slotOf)
+    {
+        auto it = index.find(key);
+        if (it == index.end()) return;
+
+        std::vector<GameObject*>& bucket = it->second;
+        GameObject* moved = bucket.back();
+        bucket[slot] = moved;
+        slotOf(moved) = slot;
+        bucket.pop_back();
+        if (bucket.empty()) index.erase(it);
+    }
+}
+
+GameObject* Scene::createObject(Mesh* mesh, const Name& name)
+{
+    PoolHandle handle = m_objects.create(mesh, name);
+    GameObject* obj = m_objects.get(handle);
+
+    Entity e = m_world.create();
+    m_world.add(e, TransformComponent{ obj->transform.getId() });
+    m_world.add(e, LegacyObject{ obj });
+    if (mesh)
+    {
+        m_world.add(e, RenderComponent{ mesh, obj->color, 0, false, false, false, false });
+        m_world.add(e, BoundsComponent());
+    }
+
+    obj->attachToScene(&m_world, e, handle);
+    obj->m_nameSlot = addToIndex(m_byName, obj->getName(), obj);
+    return obj;
+}
+
+unsigned int Scene::instantiate(const SceneFile& file, const std::vector<Mesh*>& meshes, const std::vector<unsigned int>& textures,
+    GameObject* parent, std::vector<GameObject*>* created)
+{
+    const unsigned int count = file.getObjectCount();
+
+    // roditelj uvek prethodi detetu u fajlu -> jedan prolaz
+    std::vector<GameObject*> local;
+    std::vector<GameObject*>& objects = created ? *created : local;
+    const size_t base = objects.size();
+    objects.resize(base + count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const SceneObjectRecord& rec = file.getObject(i);
+
+        GameObject* obj = createObject(rec.mesh != kSceneNone ? meshes[rec.mesh] : nullptr, Name(file.getObjectName(i)));
+        obj->transform.setPosition({ rec.position[0], rec.position[1], rec.position[2] });
+        obj->transform.setRotation({ rec.rotation[0], rec.rotation[1], rec.rotation[2] });
+        obj->transform.setScale({ rec.scale[0], rec.scale[1], rec.scale[2] });
+
+        if (rec.material != kSceneNone)
+        {
+            const SceneMaterialRecord& mat = file.getMaterial(rec.material);
+            obj->color = { mat.color[0], mat.color[1], mat.color[2] };
+            obj->transparent = (mat.flags & SceneMaterialTransparent) != 0;
+            if (mat.texture != kSceneNone)
+            {
+                obj->texture = textures[mat.texture];
+                obj->useTexture = obj->texture != 0;
+            }
+        }
+
+        obj->occluder = (rec.flags & SceneObjectOccluder) != 0;
+        obj->isStatic = (rec.flags & SceneObjectStatic) != 0;
+        obj->active = (rec.flags & SceneObjectInactive) == 0;
+
+        if (rec.parent != kSceneNone)
+            objects[base + rec.parent]->addChild(obj);
+        else if (parent)
+            parent->addChild(obj);
+
+        for (unsigned int t = 0; t < rec.tagCount; t++)
+            addTag(obj, Name(file.getObjectTag(i, t)));
+
+        objects[base + i] = obj;
+    }
+
+    return count;
+}
+
+unsigned int& Scene::tagSlot(GameObject* obj, const Name& tag)
+{
+    unsigned int i = 0;
+    while (obj->m_tags[i] != tag) i++;
+    return obj->m_tagSlots[i];
+}
+
+void Scene::unindexName(GameObject* obj)
+{
+    unindex(m_byName, obj->m_name, obj->m_nameSlot, [](GameObject* o) -> unsigned int& { return o->m_nameSlot; });
+}
+
+void Scene::unindexTag(GameObject* obj, const Name& tag)
+{
+    unindex(m_byTag, tag, tagSlot(obj, tag), [&tag](GameObject* o) -> unsigned int& { return tagSlot(o, tag); });
+}
+
+GameObject* Scene::findObject(const Name& name) const
+{
+    const std::vector<GameObject*>& bucket = lookup(m_byName, name);
+    return bucket.empty() ? nullptr : bucket.front();
+}
+
+const std::vector<GameObject*>& Scene::findObjects(const Name& name) const
+{
+    return lookup(m_byName, name);
+}
+
+void Scene::renameObject(GameObject* obj, const Name& name)
+{
+    if (obj->m_name == name) return;
+
+    unindexName(obj);
+    obj->m_name = name;
+    obj->m_nameSlot = addToIndex(m_byName, name, obj);
+}
+
+void Scene::addTag(GameObject* obj, const Name& tag)
+{
+    if (obj->hasTag(tag)) return;
+
+    obj->m_tags.push_back(tag);
+    obj->m_tagSlots.push_back(addToIndex(m_byTag, tag, obj));
+}
+
+void Scene::removeTag(GameObject* obj, const Name& tag)
+{
+    if (!obj->hasTag(tag)) return;
+    unindexTag(obj, tag);
+
+    // m_tags i m_tagSlots se uklanjaju na istom mestu, da ostanu poravnati
+    unsigned int i = 0;
+    while (obj->m_tags[i] != tag) i++;
+    obj->m_tags.removeSwapAt(i);
+    obj->m_tagSlots.removeSwapAt(i);
+}
+
+const std::vector<GameObject*>& Scene::getTagged(const Name& tag) const
+{
+    return lookup(m_byTag, tag);
+}
+
+void Scene::destroyObject(GameObject* obj)
+{
+    if (!obj || m_objects.get(obj->getHandle()) != obj) return;
+
+    obj->active = false;
+    if (std::find(m_pendingDestroy.begin(), m_pendingDestroy.end(), obj->getHandle()) == m_pendingDestroy.end())
+        m_pendingDestroy.push_back(obj->getHandle());
+}
+
+void Scene::flushDestroyed()
+{
+    // deca se unistavaju zajedno sa roditeljem
+    for (size_t i = 0; i < m_pendingDestroy.size(); i++)
+    {
+        GameObject* obj = m_objects.get(m_pendingDestroy[i]);
+        if (!obj) continue;
+
+        for (GameObject* child : obj->getChildren())
+        {
+            if (std::find(m_pendingDestroy.begin(), m_pendingDestroy.end(), child->getHandle()) == m_pendingDestroy.end())
+                m_pendingDestroy.push_back(child->getHandle());
+        }
+    }
+
+    for (PoolHandle h : m_pendingDestroy)
+    {
+        GameObject* obj = m_objects.get(h);
+        if (!obj) continue;
+
+        unindexName(obj);
+        for (const Name& tag : obj->getTags())
+            unindexTag(obj, tag);
+
+        obj->detach();
+        m_world.destroy(obj->getEntity());
+        m_objects.destroy(h);
+        m_stats.objectsDestroyed++;
+    }
+    m_pendingDestroy.clear();
+
+    // povremeno sabijanje: prazni blokovi sa kraja pool-a se vracaju kad slobodnih
+    // slotova ima vise nego zivih objekata
+    if (m_stats.objectsDestroyed && m_objects.capacity() - m_objects.size() > m_objects.size())
+        m_stats.poolSlabsReleased = m_objects.trim();
+
+    m_objectsDestroyedTotal += m_stats.objectsDestroyed;
+    m_poolSlabsReleasedTotal += m_stats.poolSlabsReleased;
+    m_stats.objectsDestroyedTotal = m_objectsDestroyedTotal;
+    m_stats.poolSlabsReleasedTotal = m_poolSlabsReleasedTotal;
+    m_stats.objectsLive = m_objects.size();
+}
+
+void Scene::clear()
 {
-    m_objects.push_back(std::make_unique<GameObject>(mesh, name));
-    return m_objects.back().get();
+    m_pendingDestroy.clear();
+    m_byName.clear();
+    m_byTag.clear();
+    m_visible.clear();
+    m_bvhObjects.clear();
+    m_bvhCandidates.clear();
+    m_bvh.clear();
+    m_staticBatch.clear();
+    m_staticCandidates.clear();
+
+    // svi Transform-i odjednom; destroy iz ~Transform u reset-u posle toga odmah izlazi
+    TransformSystem::instance().clear();
+    m_objects.reset();
+    m_world.clear();
 }
 
 void Scene::update(float)
 {
+    PROFILE_ZONE("Scene::update");
+
+    m_stats = FrameStats();
+
+    // sve svetske matrice u jednom linearnom prolazu, pre granica i BVH-a
+    flushDestroyed();
+
+    TransformSystem::instance().update();
+
+    syncLegacyObjects();
+    updateBounds();
+    updateBvh();
+    updateStaticBatch();
+
+    if (m_stats.objectsDestroyed || m_stats.staticBatchRebuilt) m_stats.sceneChanged = true;
+    if (m_stats.sceneChanged) m_changeCount++;
 }
 
-void Scene::draw(const Shader& shader, const Camera& camera)
+void Scene::updateStaticBatch()
 {
-    for (auto& obj : m_objects)
+    m_staticCandidates.clear();
+    if (m_staticBatching)
     {
-        if (!obj->transparent)
+        for (GameObject* obj : m_bvhObjects)
         {
-            shader.setFloat("u_Alpha", 1.0f);
-            obj->draw(shader, camera);
+            if (obj->isStatic && !obj->transparent && !(obj->useTexture && obj->texture != 0))
+                m_staticCandidates.push_back(obj);
         }
     }
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (m_staticBatch.isStale(m_staticCandidates))
+    {
+        m_staticBatch.build(m_staticCandidates);
+        m_stats.staticBatchRebuilt = true;
+    }
+
+    m_stats.staticObjectsBaked = m_staticBatch.getObjectCount();
+}
+
+void Scene::syncLegacyObjects()
+{
+    // active se preslikava u InactiveTag (strukturna promena -> van upita)
+    m_objects.forEach([this](GameObject& obj)
+        {
+            const Entity e = obj.getEntity();
+            if (obj.active == m_world.has<InactiveTag>(e))
+            {
+                if (obj.active) m_world.remove<InactiveTag>(e);
+                else m_world.add(e, InactiveTag());
+                m_stats.sceneChanged = true;
+            }
+        });
+
+    // javna polja GameObject-a -> RenderComponent (razlika = promenjen materijal)
+    bool changed = false;
+    m_world.each<LegacyObject, RenderComponent>([&changed](Entity, LegacyObject& legacy, RenderComponent& r)
+        {
+            const GameObject* obj = legacy.object;
+            changed = changed || r.color != obj->color || r.texture != obj->texture || r.useTexture != obj->useTexture ||
+                r.transparent != obj->transparent;
+
+            r.color = obj->color;
+            r.texture = obj->texture;
+            r.useTexture = obj->useTexture;
+            r.transparent = obj->transparent;
+            r.occluder = obj->occluder;
+            r.isStatic = obj->isStatic;
+        });
+    if (changed) m_stats.sceneChanged = true;
+}
+
+void Scene::updateBounds()
+{
+    TransformSystem& transforms = TransformSystem::instance();
+
+    m_bvhCandidates.clear();
+    m_bvhBoxes.clear();
+    m_bvhSpheres.clear();
+
+    // jedan prolaz kroz guste kolone: granice (samo za pomerene) + BVH kandidati
+    m_world.each<TransformComponent, RenderComponent, BoundsComponent, LegacyObject>(
+        [&](Entity, TransformComponent& t, RenderComponent& r, BoundsComponent& b, LegacyObject& legacy)
+        {
+            const unsigned int version = transforms.getWorldVersion(t.transformId);
+            if (!b.valid || b.transformVersion != version)
+            {
+                const glm::mat4 model = transforms.getWorldMatrix(t.transformId);
+                b.sphere = transformBounds(r.mesh->getLocalBounds(), model);
+                b.aabb = transformAabb(r.mesh->getLocalBounds(), model);
+                b.transformVersion = version;
+                b.valid = true;
+                m_stats.sceneChanged = true;
+            }
+
+            m_bvhCandidates.push_back(legacy.object);
+            m_bvhBoxes.push_back(b.aabb);
+            m_bvhSpheres.push_back(b.sphere);
+        },
+        componentMask<InactiveTag>());
+}
+
+void Scene::updateBvh()
+{
+    using clock = std::chrono::high_resolution_clock;
+
+    auto t0 = clock::now();
+
+    if (m_bvhCandidates != m_bvhObjects)
+    {
+        // promenjen skup objekata (novi, deaktivirani) -> kompletna SAH izgradnja
+        m_bvhObjects.swap(m_bvhCandidates);
+        m_bvh.build(m_bvhBoxes.data(), m_bvhSpheres.data(), (unsigned int)m_bvhObjects.size());
+
+        m_stats.bvhBuildMs = std::chrono::duration<float, std::milli>(clock::now() - t0).count();
+        return;
+    }
+
+    m_bvh.refit(m_bvhBoxes.data(), m_bvhSpheres.data());
+    auto t1 = clock::now();
+
+    m_stats.bvhSubtreesRebuilt = m_bvh.rebuildDegraded();
+    auto t2 = clock::now();
+
+    m_stats.bvhRefitMs = std::chrono::duration<float, std::milli>(t1 - t0).count();
+    m_stats.bvhRebuildMs = std::chrono::duration<float, std::milli>(t2 - t1).count();
+}
+
+GameObject* Scene::raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, float* hitDistance) const
+{
+    float t = 0.0f;
+    int hit = m_bvh.raycast(origin, dir, maxDistance, t);
+    if (hit < 0) return nullptr;
+
+    if (hitDistance) *hitDistance = t;
+    return m_bvhObjects[hit];
+}
+
+void Scene::queryProximity(const glm::vec3& center, float radius, std::vector<GameObject*>& out) const
+{
+    m_queryResult.clear();
+    m_bvh.querySphere(center, radius, m_queryResult);
+
+    for (unsigned int i : m_queryResult)
+        out.push_back(m_bvhObjects[i]);
+}
+
+void Scene::buildPacket(const Camera& camera, FramePacket& packet, float alpha)
+{
+    PROFILE_ZONE("Scene::buildPacket");
+
+    cullObjects(camera);
+
+    packet.renderPath = m_renderPath;
+    packet.oit = m_oitEnabled;
+
+    packet.staticObjectsVisible = removeBaked();
+    packet.staticVertices = m_staticBatch.getVertices();
+
+    packet.opaque.clear();
+    packet.transparent.clear();
+    for (const GameObject* obj : m_visible)
+    {
+        if (!obj->active) continue;
+
+        const unsigned int tex = (obj->useTexture && obj->texture != 0) ? obj->texture : 0;
+        DrawItem item{ obj->getMesh(), tex, obj->transform.getInterpolatedWorld(alpha), obj->color };
+
+        if (obj->transparent) packet.transparent.push_back(item);
+        else packet.opaque.push_back(item);
+    }
+
+    // grupe za instancirano crtanje se sklapaju ovde, ne na GL niti
+    if (m_renderPath == RenderPath::Batched)
+    {
+        std::stable_sort(packet.opaque.begin(), packet.opaque.end(),
+            [](const DrawItem& a, const DrawItem& b)
+            {
+                if (a.mesh != b.mesh) return a.mesh < b.mesh;
+                return a.texture < b.texture;
+            });
+    }
+}
+
+void Scene::cullObjects(const Camera& camera)
+{
+    m_visible.clear();
 
-    for (auto& obj : m_objects)
+    const unsigned int count = (unsigned int)m_bvhObjects.size();
+    const glm::mat4 viewProj = camera.getProjection() * camera.getView();
+
+    if (!m_frustumCulling)
     {
-        if (obj->transparent)
+        m_visible = m_bvhObjects;
+        m_stats.objectsVisible = count;
+        m_stats.objectsCulled = 0;
+        cullOccluded(viewProj);
+        return;
+    }
+
+    Frustum frustum(viewProj);
+
+    m_queryResult.clear();
+    m_bvh.queryFrustum(frustum, m_queryResult);
+
+    // redosled kao u m_bvhObjects (providni objekti se crtaju stabilno)
+    std::sort(m_queryResult.begin(), m_queryResult.end());
+
+    m_visible.reserve(m_queryResult.size());
+    for (unsigned int i : m_queryResult)
+        m_visible.push_back(m_bvhObjects[i]);
+
+    m_stats.objectsVisible = (unsigned int)m_visible.size();
+    m_stats.objectsCulled = count - m_stats.objectsVisible;
+
+    cullOccluded(viewProj);
+}
+
+void Scene::cullOccluded(const glm::mat4& viewProj)
+{
+    if (!m_occlusionCulling) return;
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    if (!m_occlusion) m_occlusion = std::make_unique<OcclusionCuller>();
+
+    m_occlusion->begin(viewProj);
+
+    bool anyOccluder = false;
+    for (GameObject* obj : m_visible)
+    {
+        if (obj->occluder && !obj->transparent)
         {
-            shader.setFloat("u_Alpha", 0.3f);
-            obj->draw(shader, camera);
+            m_occlusion->addOccluder(obj->getMesh()->getLocalBounds(), obj->transform.getWorldMatrix());
+            anyOccluder = true;
         }
     }
+    if (!anyOccluder) return;
 
-    glDisable(GL_BLEND);
+    m_occlusion->rasterize();
+
+    size_t kept = 0;
+    for (GameObject* obj : m_visible)
+    {
+        if (obj->occluder || m_occlusion->isVisible(obj->getWorldAabb()))
+            m_visible[kept++] = obj;
+    }
+
+    m_stats.objectsOccluded = (unsigned int)(m_visible.size() - kept);
+    m_stats.objectsVisible = (unsigned int)kept;
+    m_visible.resize(kept);
+
+    m_stats.occlusionMs = std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - t0).count();
 }
 
+unsigned int Scene::removeBaked()
+{
+    if (m_staticBatch.empty()) return 0;
+
+    // peceni objekti ostaju u BVH-u (okluderi, upiti), ali se ne crtaju pojedinacno
+    size_t kept = 0;
+    unsigned int baked = 0;
+    for (GameObject* obj : m_visible)
+    {
+        if (m_staticBatch.contains(obj))
+            baked++;
+        else
+            m_visible[kept++] = obj;
+    }
+    m_visible.resize(kept);
+    return baked;
+}
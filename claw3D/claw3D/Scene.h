@@ -2,26 +2,146 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include "FrameStats.h"
+#include "FramePacket.h"
+#include "Mesh.h"
+#include "Bvh.h"
+#include "StaticBatch.h"
+#include "Ecs.h"
+#include "ObjectPool.h"
+#include "Name.h"
 
 class GameObject;
-class Shader;
+class OcclusionCuller;
 class Camera;
-class Mesh;
+class SceneFile;
 
 class Scene
 {
 public:
-    Scene() = default;
-    ~Scene() = default;
+    Scene();
+    ~Scene();
 
-    GameObject* createObject(Mesh* mesh, const std::string& name = "");
+    // kompatibilni sloj: GameObject + ECS entitet (Transform, Render, Bounds, LegacyObject)
+    GameObject* createObject(Mesh* mesh, const Name& name = Name());
+
+    // pravi sve objekte iz mapiranog .scn fajla; meshes/textures su resursi razreseni po
+    // indeksima iz fajla (ucitava ih pozivalac, vidi Prefab). Koreni fajla postaju deca parent-a
+    // ako je zadat. Vraca broj napravljenih objekata; created dobija objekte redom iz fajla.
+    unsigned int instantiate(const SceneFile& file, const std::vector<Mesh*>& meshes, const std::vector<unsigned int>& textures,
+        GameObject* parent = nullptr, std::vector<GameObject*>* created = nullptr);
+
+    EcsWorld& getWorld() { return m_world; }
+
+    // stabilna rucka -> objekat; nullptr ako je objekat u medjuvremenu unisten
+    GameObject* getObject(PoolHandle handle) const { return m_objects.get(handle); }
+    unsigned int getObjectCount() const { return m_objects.size(); }
+
+    // odlozeno unistavanje: objekat se odmah sakriva, a oslobadja (zajedno sa decom) na
+    // pocetku sledeceg update-a, kad ga vise nista iz tekuceg frejma ne referencira
+    void destroyObject(GameObject* obj);
+
+    // ===== INDEKS PO IMENU I TAGU (hes internovanog imena, O(1)) =====
+    // prvi objekat sa datim imenom; nullptr ako ga nema
+    GameObject* findObject(const Name& name) const;
+    const std::vector<GameObject*>& findObjects(const Name& name) const;
+
+    void renameObject(GameObject* obj, const Name& name);
+
+    void addTag(GameObject* obj, const Name& tag);
+    void removeTag(GameObject* obj, const Name& tag);
+
+    // svi objekti sa tagom (npr. "toy"); redosled nije definisan
+    const std::vector<GameObject*>& getTagged(const Name& tag) const;
+
+    // unistava sve objekte odjednom (pool i ECS zadrzavaju memoriju za sledecu scenu)
+    void clear();
 
     void update(float dt);
-    void draw(const Shader& shader, const Camera& camera);
+
+    // culling + lista za crtanje u packet (kamera i svetlo su vec upisani); bez GL poziva,
+    // paket crta SceneRenderer, na ovoj ili na render niti. alpha = polozaj izmedju poslednja
+    // dva koraka simulacije (matrice se interpoliraju, culling koristi tekuce granice)
+    void buildPacket(const Camera& camera, FramePacket& packet, float alpha = 1.0f);
+
+    void setRenderPath(RenderPath path) { m_renderPath = path; }
+    RenderPath getRenderPath() const { return m_renderPath; }
+
+    // weighted blended OIT za providne objekte (ako ga SceneRenderer ima); inace alpha blend
+    void setOitEnabled(bool enabled) { m_oitEnabled = enabled; }
+    bool getOitEnabled() const { return m_oitEnabled; }
+
+    // pecenje isStatic objekata u jedan bafer (SceneRenderer mora da ima baked shader)
+    void setStaticBatching(bool enabled) { m_staticBatching = enabled; }
+
+    void setFrustumCulling(bool enabled) { m_frustumCulling = enabled; }
+    bool getFrustumCulling() const { return m_frustumCulling; }
+
+    void setOcclusionCulling(bool enabled) { m_occlusionCulling = enabled; }
+    bool getOcclusionCulling() const { return m_occlusionCulling; }
+
+    // ===== PROSTORNI UPITI (BVH, stanje iz poslednjeg update-a) =====
+    GameObject* raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, float* hitDistance = nullptr) const;
+    void queryProximity(const glm::vec3& center, float radius, std::vector<GameObject*>& out) const;
+
+    const FrameStats& getStats() const { return m_stats; }
+
+    // raste sa svakim update-om u kome se nesto vidljivo promenilo (FrameStats::sceneChanged);
+    // ista vrednost = ista slika (za istu kameru), pa crtanje moze da se preskoci
+    unsigned int getChangeCount() const { return m_changeCount; }
 
 private:
-    std::vector<std::unique_ptr<GameObject>> m_objects;
+    void flushDestroyed();
+    // uklanjanje iz m_byName/m_byTag preko slotova zapamcenih u GameObject-u
+    void unindexName(GameObject* obj);
+    void unindexTag(GameObject* obj, const Name& tag);
+    static unsigned int& tagSlot(GameObject* obj, const Name& tag);
+    void syncLegacyObjects();
+    void updateBounds();
+    void updateBvh();
+    void updateStaticBatch();
+    void cullObjects(const Camera& camera);
+    void cullOccluded(const glm::mat4& viewProj);
+    unsigned int removeBaked();
+
+private:
+    EcsWorld m_world;
+    ObjectPool<GameObject> m_objects;
+    std::vector<PoolHandle> m_pendingDestroy;
+
+    typedef std::unordered_map<Name, std::vector<GameObject*>, NameHash> ObjectIndex;
+    ObjectIndex m_byName;
+    ObjectIndex m_byTag;
+
     Mesh* bearMesh = nullptr;
     GameObject* bearObject = nullptr;
 
+    // rezultat culling-a za tekuci frejm (redosled kao u m_bvhObjects)
+    std::vector<GameObject*> m_visible;
+
+    bool m_frustumCulling = true;
+    bool m_occlusionCulling = true;
+    std::unique_ptr<OcclusionCuller> m_occlusion;
+
+    // BVH elementi: aktivni objekti sa mesh-om, u redosledu ECS upita
+    Bvh m_bvh;
+    std::vector<GameObject*> m_bvhObjects;
+    std::vector<GameObject*> m_bvhCandidates;
+    std::vector<Aabb> m_bvhBoxes;
+    std::vector<BoundingSphere> m_bvhSpheres;
+    mutable std::vector<unsigned int> m_queryResult;
+
+    RenderPath m_renderPath = RenderPath::Classic;
+    bool m_oitEnabled = true;
+
+    // isStatic objekti peceni u jedan bafer; izbacuju se iz m_visible posle culling-a
+    StaticBatch m_staticBatch;
+    std::vector<GameObject*> m_staticCandidates;
+    bool m_staticBatching = true;
+
+    FrameStats m_stats;
+    unsigned int m_objectsDestroyedTotal = 0;
+    unsigned int m_poolSlabsReleasedTotal = 0;
+    unsigned int m_changeCount = 0;
 };
@@ -0,0 +1,441 @@
+#include "SceneFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ===== MAPIRANJE =====
+
+SceneFile::~SceneFile()
+{
+    close();
+}
+
+bool SceneFile::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        std::cerr << "Scene file not found: " << path << "\n";
+        return false;
+    }
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(SceneFileHeader))
+    {
+        std::cerr << "Scene file too small: " << path << "\n";
+        close();
+        return false;
+    }
+    m_size = (size_t)size.QuadPart;
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping)
+        m_data = (const unsigned char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    m_fd = ::open(path.c_str(), O_RDONLY);
+    if (m_fd < 0)
+    {
+        std::cerr << "Scene file not found: " << path << "\n";
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(m_fd, &st) != 0 || st.st_size < (off_t)sizeof(SceneFileHeader))
+    {
+        std::cerr << "Scene file too small: " << path << "\n";
+        close();
+        return false;
+    }
+    m_size = (size_t)st.st_size;
+
+    void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (view != MAP_FAILED)
+        m_data = (const unsigned char*)view;
+#endif
+
+    if (!m_data)
+    {
+        std::cerr << "Scene file mapping failed: " << path << "\n";
+        close();
+        return false;
+    }
+
+    if (!validate())
+    {
+        std::cerr << "Scene file invalid or wrong version: " << path << "\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SceneFile::close()
+{
+#ifdef _WIN32
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle((HANDLE)m_mapping);
+    if (m_file) CloseHandle((HANDLE)m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_data) munmap((void*)m_data, m_size);
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_meshes = nullptr;
+    m_textures = nullptr;
+    m_materials = nullptr;
+    m_objects = nullptr;
+    m_tags = nullptr;
+    m_strings = nullptr;
+}
+
+// ofseti -> pokazivaci; provera opsega je jedini prolaz kroz zapise (nema parsiranja polja)
+bool SceneFile::validate()
+{
+    const SceneFileHeader* h = (const SceneFileHeader*)m_data;
+    if (h->magic != kSceneFileMagic || h->version != kSceneFileVersion || h->fileSize != m_size)
+        return false;
+
+    auto section = [&](uint32_t offset, uint32_t count, size_t elementSize) -> const void*
+        {
+            if (offset % 4 != 0 || offset > m_size || (m_size - offset) / elementSize < count)
+                return nullptr;
+            return m_data + offset;
+        };
+
+    m_meshes = (const SceneMeshRecord*)section(h->meshOffset, h->meshCount, sizeof(SceneMeshRecord));
+    m_textures = (const SceneTextureRecord*)section(h->textureOffset, h->textureCount, sizeof(SceneTextureRecord));
+    m_materials = (const SceneMaterialRecord*)section(h->materialOffset, h->materialCount, sizeof(SceneMaterialRecord));
+    m_objects = (const SceneObjectRecord*)section(h->objectOffset, h->objectCount, sizeof(SceneObjectRecord));
+    m_tags = (const uint32_t*)section(h->tagOffset, h->tagCount, sizeof(uint32_t));
+    m_strings = (const char*)section(h->stringsOffset, h->stringsSize, 1);
+    if (!m_meshes || !m_textures || !m_materials || !m_objects || !m_tags || !m_strings)
+        return false;
+
+    // svaki string mora da se zavrsi unutar tabele
+    if (h->stringsSize == 0 || m_strings[h->stringsSize - 1] != '\0')
+        return false;
+
+    const uint32_t strings = h->stringsSize;
+    for (uint32_t i = 0; i < h->meshCount; i++)
+        if (m_meshes[i].path >= strings) return false;
+    for (uint32_t i = 0; i < h->textureCount; i++)
+        if (m_textures[i].path >= strings) return false;
+    for (uint32_t i = 0; i < h->tagCount; i++)
+        if (m_tags[i] >= strings) return false;
+
+    for (uint32_t i = 0; i < h->materialCount; i++)
+    {
+        const SceneMaterialRecord& m = m_materials[i];
+        if (m.name >= strings || m.texture >= (int32_t)h->textureCount || m.texture < kSceneNone)
+            return false;
+    }
+
+    for (uint32_t i = 0; i < h->objectCount; i++)
+    {
+        const SceneObjectRecord& o = m_objects[i];
+        if (o.name >= strings) return false;
+        if (o.parent < kSceneNone || o.parent >= (int32_t)i) return false;     // roditelj pre deteta
+        if (o.mesh < kSceneNone || o.mesh >= (int32_t)h->meshCount) return false;
+        if (o.material < kSceneNone || o.material >= (int32_t)h->materialCount) return false;
+        if (o.firstTag > h->tagCount || h->tagCount - o.firstTag < o.tagCount) return false;
+    }
+
+    m_header = h;
+    return true;
+}
+
+// ===== OFFLINE KONVERTER (tekst -> .scn) =====
+
+namespace
+{
+    class StringTable
+    {
+    public:
+        StringTable() { m_data.push_back('\0'); }   // ofset 0 = prazan string
+
+        uint32_t add(const std::string& s)
+        {
+            if (s.empty()) return 0;
+            auto it = m_offsets.find(s);
+            if (it != m_offsets.end()) return it->second;
+
+            uint32_t offset = (uint32_t)m_data.size();
+            m_data.insert(m_data.end(), s.begin(), s.end());
+            m_data.push_back('\0');
+            m_offsets.emplace(s, offset);
+            return offset;
+        }
+
+        const std::vector<char>& data() const { return m_data; }
+
+    private:
+        std::vector<char> m_data;
+        std::unordered_map<std::string, uint32_t> m_offsets;
+    };
+
+    bool readVec3(std::istringstream& ls, float out[3])
+    {
+        return (bool)(ls >> out[0] >> out[1] >> out[2]);
+    }
+
+    const int32_t kUnresolved = -2;
+
+    template <typename T>
+    void writeSection(std::ofstream& out, const std::vector<T>& items)
+    {
+        if (!items.empty())
+            out.write((const char*)items.data(), (std::streamsize)(items.size() * sizeof(T)));
+    }
+}
+
+bool compileSceneText(const std::string& textPath, const std::string& binaryPath, std::string& error)
+{
+    std::ifstream in(textPath);
+    if (!in)
+    {
+        error = "cannot open " + textPath;
+        return false;
+    }
+
+    std::vector<SceneMeshRecord> meshes;
+    std::vector<SceneTextureRecord> textures;
+    std::vector<SceneMaterialRecord> materials;
+    std::vector<SceneObjectRecord> objects;
+    std::vector<uint32_t> tags;
+    StringTable strings;
+
+    // imena iz tekstualnog oblika -> indeksi (u binarnom obliku ostaju samo indeksi)
+    std::unordered_map<std::string, int32_t> meshByAlias;
+    std::unordered_map<std::string, int32_t> textureByAlias;
+    std::unordered_map<std::string, int32_t> materialByName;
+    std::unordered_map<std::string, int32_t> objectByName;   // poslednji objekat sa tim imenom
+
+    enum class Block { None, Material, Object };
+    Block block = Block::None;
+    SceneMaterialRecord material = {};
+    SceneObjectRecord object = {};
+    std::string blockName;
+    std::vector<uint32_t> objectTags;
+
+    int lineNo = 0;
+    auto fail = [&](const std::string& message)
+        {
+            error = textPath + ":" + std::to_string(lineNo) + ": " + message;
+            return false;
+        };
+
+    auto lookup = [](const std::unordered_map<std::string, int32_t>& map, const std::string& key) -> int32_t
+        {
+            if (key == "-") return kSceneNone;
+            auto it = map.find(key);
+            return it != map.end() ? it->second : kUnresolved;
+        };
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        lineNo++;
+
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream ls(line);
+        std::string key;
+        if (!(ls >> key)) continue;
+
+        if (block == Block::None)
+        {
+            if (key == "mesh" || key == "texture")
+            {
+                std::string alias, path;
+                if (!(ls >> alias >> path)) return fail(key + " expects <alias> <path>");
+
+                auto& byAlias = (key == "mesh") ? meshByAlias : textureByAlias;
+                if (byAlias.count(alias)) return fail("duplicate " + key + " '" + alias + "'");
+
+                if (key == "mesh")
+                {
+                    byAlias[alias] = (int32_t)meshes.size();
+                    meshes.push_back({ strings.add(path) });
+                }
+                else
+                {
+                    byAlias[alias] = (int32_t)textures.size();
+                    textures.push_back({ strings.add(path) });
+                }
+            }
+            else if (key == "material" || key == "object")
+            {
+                if (!(ls >> blockName)) return fail(key + " expects a name");
+
+                if (key == "material")
+                {
+                    if (materialByName.count(blockName)) return fail("duplicate material '" + blockName + "'");
+                    material = SceneMaterialRecord();
+                    material.name = strings.add(blockName);
+                    material.color[0] = 1.0f;       // isto kao podrazumevana boja GameObject-a
+                    material.texture = kSceneNone;
+                    block = Block::Material;
+                }
+                else
+                {
+                    object = SceneObjectRecord();
+                    object.name = strings.add(blockName);
+                    object.parent = kSceneNone;
+                    object.mesh = kSceneNone;
+                    object.material = kSceneNone;
+                    object.scale[0] = object.scale[1] = object.scale[2] = 1.0f;
+                    objectTags.clear();
+                    block = Block::Object;
+                }
+            }
+            else
+            {
+                return fail("unknown directive '" + key + "'");
+            }
+        }
+        else if (key == "end")
+        {
+            if (block == Block::Material)
+            {
+                materialByName[blockName] = (int32_t)materials.size();
+                materials.push_back(material);
+            }
+            else
+            {
+                object.firstTag = (uint32_t)tags.size();
+                object.tagCount = (uint32_t)objectTags.size();
+                tags.insert(tags.end(), objectTags.begin(), objectTags.end());
+
+                objectByName[blockName] = (int32_t)objects.size();
+                objects.push_back(object);
+            }
+            block = Block::None;
+        }
+        else if (block == Block::Material)
+        {
+            if (key == "color")
+            {
+                if (!readVec3(ls, material.color)) return fail("color expects 3 numbers");
+            }
+            else if (key == "texture")
+            {
+                std::string alias;
+                ls >> alias;
+                material.texture = lookup(textureByAlias, alias);
+                if (material.texture == kUnresolved) return fail("unknown texture '" + alias + "'");
+            }
+            else if (key == "transparent")
+            {
+                material.flags |= SceneMaterialTransparent;
+            }
+            else
+            {
+                return fail("unknown material property '" + key + "'");
+            }
+        }
+        else
+        {
+            if (key == "mesh" || key == "material" || key == "parent")
+            {
+                std::string ref;
+                ls >> ref;
+
+                int32_t& slot = (key == "mesh") ? object.mesh : (key == "material") ? object.material : object.parent;
+                slot = lookup((key == "mesh") ? meshByAlias : (key == "material") ? materialByName : objectByName, ref);
+                if (slot == kUnresolved) return fail("unknown " + key + " '" + ref + "'");
+            }
+            else if (key == "position" || key == "rotation" || key == "scale")
+            {
+                float* v = (key == "position") ? object.position : (key == "rotation") ? object.rotation : object.scale;
+                if (!readVec3(ls, v)) return fail(key + " expects 3 numbers");
+            }
+            else if (key == "tag")
+            {
+                std::string tag;
+                if (!(ls >> tag)) return fail("tag expects a name");
+                objectTags.push_back(strings.add(tag));
+            }
+            else if (key == "occluder") object.flags |= SceneObjectOccluder;
+            else if (key == "static") object.flags |= SceneObjectStatic;
+            else if (key == "inactive") object.flags |= SceneObjectInactive;
+            else
+            {
+                return fail("unknown object property '" + key + "'");
+            }
+        }
+
+        std::string extra;
+        if (ls >> extra) return fail("unexpected '" + extra + "'");
+    }
+
+    if (block != Block::None) return fail("missing 'end' for '" + blockName + "'");
+
+    // raspored: zaglavlje, zapisi (svi su umnozak 4 bajta), pa stringovi na kraju
+    SceneFileHeader header = {};
+    header.magic = kSceneFileMagic;
+    header.version = kSceneFileVersion;
+
+    uint32_t offset = sizeof(SceneFileHeader);
+    auto place = [&](uint32_t& count, uint32_t& sectionOffset, size_t itemCount, size_t itemSize)
+        {
+            count = (uint32_t)itemCount;
+            sectionOffset = offset;
+            offset += (uint32_t)(itemCount * itemSize);
+        };
+    place(header.meshCount, header.meshOffset, meshes.size(), sizeof(SceneMeshRecord));
+    place(header.textureCount, header.textureOffset, textures.size(), sizeof(SceneTextureRecord));
+    place(header.materialCount, header.materialOffset, materials.size(), sizeof(SceneMaterialRecord));
+    place(header.objectCount, header.objectOffset, objects.size(), sizeof(SceneObjectRecord));
+    place(header.tagCount, header.tagOffset, tags.size(), sizeof(uint32_t));
+    place(header.stringsSize, header.stringsOffset, strings.data().size(), 1);
+    header.fileSize = offset;
+
+    std::ofstream out(binaryPath, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        error = "cannot write " + binaryPath;
+        return false;
+    }
+
+    out.write((const char*)&header, sizeof(header));
+    writeSection(out, meshes);
+    writeSection(out, textures);
+    writeSection(out, materials);
+    writeSection(out, objects);
+    writeSection(out, tags);
+    writeSection(out, strings.data());
+
+    if (!out)
+    {
+        error = "write failed: " + binaryPath;
+        return false;
+    }
+    return true;
+}
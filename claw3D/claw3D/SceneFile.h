@@ -0,0 +1,139 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Binarni format scene (.scn), verzionisan. Fajl se mapira u memoriju i koristi na licu
+// mesta: svi zapisi su POD fiksne velicine (little-endian, poravnati na 4 bajta), a veze
+// izmedju njih su ofseti od pocetka fajla, pa ucitavanje ne parsira nista polje po polje.
+//
+//   SceneFileHeader
+//   SceneMeshRecord[meshCount]         putanja OBJ-a ili "builtin:cube" / "builtin:sphere"
+//   SceneTextureRecord[textureCount]
+//   SceneMaterialRecord[materialCount]
+//   SceneObjectRecord[objectCount]     roditelj uvek prethodi deci
+//   uint32_t tags[tagCount]            ofseti imena tagova (objekat pokazuje na svoj raspon)
+//   char strings[stringsSize]          NUL-terminisani stringovi
+//
+// Tekstualni oblik (scenes/*.txt) se pise rucno i prevodi offline: claw3D --bake-scene in out.
+
+static const uint32_t kSceneFileMagic = 0x4E435343u;   // "CSCN" u fajlu
+static const uint32_t kSceneFileVersion = 1;
+static const int32_t kSceneNone = -1;
+
+enum SceneMaterialFlags : uint32_t
+{
+    SceneMaterialTransparent = 1u << 0,
+};
+
+enum SceneObjectFlags : uint32_t
+{
+    SceneObjectOccluder = 1u << 0,
+    SceneObjectStatic = 1u << 1,
+    SceneObjectInactive = 1u << 2,
+};
+
+struct SceneFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fileSize;
+
+    uint32_t meshCount, meshOffset;
+    uint32_t textureCount, textureOffset;
+    uint32_t materialCount, materialOffset;
+    uint32_t objectCount, objectOffset;
+    uint32_t tagCount, tagOffset;
+    uint32_t stringsSize, stringsOffset;
+};
+
+struct SceneMeshRecord
+{
+    uint32_t path;          // ofset u tabeli stringova
+};
+
+struct SceneTextureRecord
+{
+    uint32_t path;
+};
+
+struct SceneMaterialRecord
+{
+    uint32_t name;
+    float color[3];
+    int32_t texture;        // indeks teksture ili kSceneNone
+    uint32_t flags;         // SceneMaterialFlags
+};
+
+struct SceneObjectRecord
+{
+    uint32_t name;
+    int32_t parent;         // indeks objekta ili kSceneNone
+    int32_t mesh;           // kSceneNone = prazan cvor (npr. ClawRoot)
+    int32_t material;
+    uint32_t flags;         // SceneObjectFlags
+    uint32_t firstTag;
+    uint32_t tagCount;
+    float position[3];
+    float rotation[3];      // Euler stepeni
+    float scale[3];
+};
+
+static_assert(sizeof(SceneFileHeader) == 60, "SceneFileHeader se menja samo sa novom verzijom");
+static_assert(sizeof(SceneMaterialRecord) == 24, "SceneMaterialRecord se menja samo sa novom verzijom");
+static_assert(sizeof(SceneObjectRecord) == 64, "SceneObjectRecord se menja samo sa novom verzijom");
+
+// Pogled na mapiran .scn fajl (samo za citanje). Pokazivaci vaze dok je fajl otvoren.
+class SceneFile
+{
+public:
+    SceneFile() = default;
+    ~SceneFile();
+
+    SceneFile(const SceneFile&) = delete;
+    SceneFile& operator=(const SceneFile&) = delete;
+
+    // mapira fajl i proverava zaglavlje i opsege; false (+ poruka) ako fajl ne valja
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    unsigned int getMeshCount() const { return m_header->meshCount; }
+    unsigned int getTextureCount() const { return m_header->textureCount; }
+    unsigned int getMaterialCount() const { return m_header->materialCount; }
+    unsigned int getObjectCount() const { return m_header->objectCount; }
+
+    const char* getMeshPath(unsigned int i) const { return getString(m_meshes[i].path); }
+    const char* getTexturePath(unsigned int i) const { return getString(m_textures[i].path); }
+    const SceneMaterialRecord& getMaterial(unsigned int i) const { return m_materials[i]; }
+    const SceneObjectRecord& getObject(unsigned int i) const { return m_objects[i]; }
+
+    const char* getObjectName(unsigned int i) const { return getString(m_objects[i].name); }
+    const char* getObjectTag(unsigned int i, unsigned int t) const { return getString(m_tags[m_objects[i].firstTag + t]); }
+
+    const char* getString(uint32_t offset) const { return m_strings + offset; }
+
+private:
+    bool validate();
+
+private:
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+
+    const SceneFileHeader* m_header = nullptr;
+    const SceneMeshRecord* m_meshes = nullptr;
+    const SceneTextureRecord* m_textures = nullptr;
+    const SceneMaterialRecord* m_materials = nullptr;
+    const SceneObjectRecord* m_objects = nullptr;
+    const uint32_t* m_tags = nullptr;
+    const char* m_strings = nullptr;
+};
+
+// offline konverter: tekstualni oblik -> .scn; false + error (sa brojem linije) pri gresci
+bool compileSceneText(const std::string& textPath, const std::string& binaryPath, std::string& error);
@@ -0,0 +1,240 @@
+#include <glad/glad.h>
+#include "SceneRenderer.h"
+#include "Shader.h"
+#include "OitPass.h"
+#include "GLState.h"
+#include "StaticBatch.h"
+
+SceneRenderer::~SceneRenderer()
+{
+    if (m_instanceVBO)
+    {
+        glDeleteBuffers(1, &m_instanceVBO);
+        GLState::onBufferDeleted(m_instanceVBO);
+    }
+    if (m_staticVBO)
+    {
+        glDeleteBuffers(1, &m_staticVBO);
+        GLState::onBufferDeleted(m_staticVBO);
+    }
+    if (m_staticVAO)
+    {
+        glDeleteVertexArrays(1, &m_staticVAO);
+        GLState::onVertexArrayDeleted(m_staticVAO);
+    }
+}
+
+void SceneRenderer::setShaders(const Shader* basic, const Shader* instanced, const Shader* baked)
+{
+    m_shader = basic;
+    m_instancedShader = instanced;
+    m_bakedShader = baked;
+}
+
+void SceneRenderer::draw(const FramePacket& packet)
+{
+    m_stats.drawCalls = 0;
+    m_stats.objectsDrawn = 0;
+    m_stats.batches = 0;
+
+    if (!m_shader) return;
+
+    setFrameUniforms(packet);
+    drawStaticBatch(packet);
+
+    if (packet.renderPath == RenderPath::Batched && m_instancedShader)
+        drawOpaqueBatched(packet);
+    else
+        drawOpaqueClassic(packet);
+
+    if (packet.transparent.empty()) return;
+
+    if (packet.oit && m_oit && m_oit->isReady() && m_oitShader)
+        drawTransparentOit(packet);
+    else
+        drawTransparentBlended(packet);
+}
+
+void SceneRenderer::setFrameUniforms(const FramePacket& packet)
+{
+    for (const Shader* shader : { m_shader, m_instancedShader, m_oitShader, m_bakedShader })
+    {
+        if (!shader) continue;
+
+        shader->use();
+        shader->setVec3("u_LightPos", packet.lightPos);
+        shader->setVec3("u_LightColor", packet.lightColor);
+        shader->setVec3("u_AmbientColor", packet.ambientColor);
+        shader->setFloat("u_AmbientStrength", packet.ambientStrength);
+        shader->setVec3("u_ViewPos", packet.viewPos);
+        shader->setFloat("u_Shininess", 32.0f);
+        shader->setMat4("u_View", packet.view);
+        shader->setMat4("u_Projection", packet.projection);
+    }
+}
+
+void SceneRenderer::drawStaticBatch(const FramePacket& packet)
+{
+    if (!m_bakedShader || !packet.staticVertices) return;
+
+    if (packet.staticVertices != m_staticUploaded)
+    {
+        const std::vector<float>& baked = *packet.staticVertices;
+
+        if (!m_staticVAO)
+        {
+            glGenVertexArrays(1, &m_staticVAO);
+            glGenBuffers(1, &m_staticVBO);
+
+            GLState::bindVertexArray(m_staticVAO);
+            GLState::bindArrayBuffer(m_staticVBO);
+
+            const GLsizei stride = StaticBatch::kStrideFloats * sizeof(float);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
+            glEnableVertexAttribArray(2);
+        }
+
+        GLState::bindArrayBuffer(m_staticVBO);
+        glBufferData(GL_ARRAY_BUFFER, baked.size() * sizeof(float), baked.data(), GL_STATIC_DRAW);
+
+        m_staticVertexCount = (unsigned int)(baked.size() / StaticBatch::kStrideFloats);
+        m_staticUploaded = packet.staticVertices;
+    }
+
+    // ceo bafer se crta cim je bar jedan peceni objekat vidljiv
+    if (packet.staticObjectsVisible == 0 || m_staticVertexCount == 0) return;
+
+    m_bakedShader->use();
+    m_bakedShader->setInt("u_UseTexture", 0);
+    m_bakedShader->setFloat("u_Alpha", 1.0f);
+
+    GLState::bindVertexArray(m_staticVAO);
+    glDrawArrays(GL_TRIANGLES, 0, m_staticVertexCount);
+
+    m_stats.drawCalls++;
+    m_stats.batches++;
+    m_stats.objectsDrawn += packet.staticObjectsVisible;
+}
+
+void SceneRenderer::drawItem(const Shader& shader, const DrawItem& item)
+{
+    shader.setMat4("u_Model", item.model);
+    shader.setVec3("u_ObjectColor", item.color);
+
+    // tekstura
+    shader.setInt("u_UseTexture", item.texture != 0 ? 1 : 0);
+    if (item.texture != 0)
+    {
+        GLState::bindTexture2D(0, item.texture);
+        shader.setInt("u_Texture", 0);
+    }
+
+    item.mesh->draw();
+
+    m_stats.drawCalls++;
+    m_stats.objectsDrawn++;
+}
+
+void SceneRenderer::drawOpaqueClassic(const FramePacket& packet)
+{
+    const Shader& shader = *m_shader;
+    shader.use();
+    shader.setFloat("u_Alpha", 1.0f);
+
+    for (const DrawItem& item : packet.opaque)
+        drawItem(shader, item);
+}
+
+void SceneRenderer::drawTransparentBlended(const FramePacket& packet)
+{
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    const Shader& shader = *m_shader;
+    shader.use();
+    shader.setFloat("u_Alpha", 0.3f);
+
+    for (const DrawItem& item : packet.transparent)
+        drawItem(shader, item);
+
+    GLState::disable(GL_BLEND);
+}
+
+void SceneRenderer::drawTransparentOit(const FramePacket& packet)
+{
+    // redosled crtanja nije bitan -> nema sortiranja po dubini
+    m_oit->begin();
+
+    const Shader& shader = *m_oitShader;
+    shader.use();
+    shader.setFloat("u_Alpha", 0.3f);
+
+    for (const DrawItem& item : packet.transparent)
+        drawItem(shader, item);
+
+    m_oit->resolve();
+    m_stats.drawCalls++;
+}
+
+void SceneRenderer::drawOpaqueBatched(const FramePacket& packet)
+{
+    const std::vector<DrawItem>& items = packet.opaque;
+    if (items.empty()) return;
+
+    // ===== 1. UPISI SVE INSTANCE U JEDAN BAFER (paket je vec sortiran po (mesh, tekstura)) =====
+    m_instances.resize(items.size());
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        m_instances[i].model = items[i].model;
+        m_instances[i].color = glm::vec4(items[i].color, 1.0f);
+    }
+
+    if (!m_instanceVBO) glGenBuffers(1, &m_instanceVBO);
+
+    GLState::bindArrayBuffer(m_instanceVBO);
+    const size_t bytes = m_instances.size() * sizeof(MeshInstance);
+    if (bytes > m_instanceCapacity)
+    {
+        m_instanceCapacity = bytes * 2;
+        glBufferData(GL_ARRAY_BUFFER, m_instanceCapacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_instances.data());
+
+    // ===== 2. JEDAN POZIV PO GRUPI =====
+    const Shader& shader = *m_instancedShader;
+    shader.use();
+    shader.setFloat("u_Alpha", 1.0f);
+
+    size_t first = 0;
+    while (first < items.size())
+    {
+        size_t last = first + 1;
+        while (last < items.size() &&
+            items[last].mesh == items[first].mesh &&
+            items[last].texture == items[first].texture)
+        {
+            last++;
+        }
+
+        unsigned int tex = items[first].texture;
+        shader.setInt("u_UseTexture", tex != 0 ? 1 : 0);
+        if (tex != 0)
+        {
+            GLState::bindTexture2D(0, tex);
+            shader.setInt("u_Texture", 0);
+        }
+
+        unsigned int count = (unsigned int)(last - first);
+        items[first].mesh->drawInstanced(m_instanceVBO, first * sizeof(MeshInstance), count);
+
+        m_stats.drawCalls++;
+        m_stats.batches++;
+        m_stats.objectsDrawn += count;
+
+        first = last;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include "FramePacket.h"
+#include "FrameStats.h"
+#include "Mesh.h"
+
+class Shader;
+class OitPass;
+
+// GL strana crtanja scene: izvrsava FramePacket koji je pripremila simulacija (Scene::buildPacket).
+// Poziva se samo sa niti koja drzi GL kontekst (glavna nit ili render nit, vidi Application).
+class SceneRenderer
+{
+public:
+    SceneRenderer() = default;
+    ~SceneRenderer();
+
+    SceneRenderer(const SceneRenderer&) = delete;
+    SceneRenderer& operator=(const SceneRenderer&) = delete;
+
+    // basic: Classic putanja i providni objekti; instanced: Batched (bez njega Classic);
+    // baked: pecena staticka geometrija (baked.vert + basic.frag)
+    void setShaders(const Shader* basic, const Shader* instanced, const Shader* baked);
+
+    // providni prolaz preko weighted blended OIT (oit_accum.frag); bez njega klasican alpha blend
+    void setOitPass(OitPass* oit, const Shader* accumShader) { m_oit = oit; m_oitShader = accumShader; }
+
+    // svetlo i kamera u sve shadere, pa scena; brojaci se upisuju u getStats()
+    void draw(const FramePacket& packet);
+
+    // drawCalls / objectsDrawn / batches poslednjeg draw()
+    const RenderStats& getStats() const { return m_stats; }
+
+private:
+    void setFrameUniforms(const FramePacket& packet);
+    void drawStaticBatch(const FramePacket& packet);
+    void drawOpaqueClassic(const FramePacket& packet);
+    void drawOpaqueBatched(const FramePacket& packet);
+    void drawTransparentBlended(const FramePacket& packet);
+    void drawTransparentOit(const FramePacket& packet);
+    void drawItem(const Shader& shader, const DrawItem& item);
+
+private:
+    const Shader* m_shader = nullptr;
+    const Shader* m_instancedShader = nullptr;
+    const Shader* m_bakedShader = nullptr;
+
+    OitPass* m_oit = nullptr;
+    const Shader* m_oitShader = nullptr;
+
+    std::vector<MeshInstance> m_instances;
+    unsigned int m_instanceVBO = 0;
+    size_t m_instanceCapacity = 0;
+
+    // GL kopija pecene geometrije; novi niz iz paketa (drugi pokazivac) -> ponovni upload
+    std::shared_ptr<const std::vector<float>> m_staticUploaded;
+    unsigned int m_staticVAO = 0;
+    unsigned int m_staticVBO = 0;
+    unsigned int m_staticVertexCount = 0;
+
+    RenderStats m_stats;
+};
@@ -1,4 +1,5 @@
 #include "Shader.h"
+#include "GLState.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
@@ -61,33 +62,47 @@ Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
 
 Shader::~Shader()
 {
-    if (m_ID) glDeleteProgram(m_ID);
+    if (m_ID)
+    {
+        glDeleteProgram(m_ID);
+        GLState::onProgramDeleted(m_ID);
+    }
 }
 
 void Shader::use() const
 {
-    glUseProgram(m_ID);
+    GLState::useProgram(m_ID);
 }
 
-void Shader::setMat4(const std::string& name, const glm::mat4& value) const
+int Shader::getLocation(const std::string& name) const
 {
+    auto it = m_locations.find(name);
+    if (it != m_locations.end()) return it->second;
+
     int loc = glGetUniformLocation(m_ID, name.c_str());
+    m_locations.emplace(name, loc);
+    return loc;
+}
+
+void Shader::setMat4(const std::string& name, const glm::mat4& value) const
+{
+    int loc = getLocation(name);
     glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
 }
 
 void Shader::setVec3(const std::string& name, const glm::vec3& value) const
 {
-    int loc = glGetUniformLocation(m_ID, name.c_str());
+    int loc = getLocation(name);
     glUniform3fv(loc, 1, glm::value_ptr(value));
 }
 
 void Shader::setFloat(const std::string& name, float value) const
 {
-    int loc = glGetUniformLocation(m_ID, name.c_str());
+    int loc = getLocation(name);
     glUniform1f(loc, value);
 }
 void Shader::setInt(const std::string& name, int value) const
 {
-    int loc = glGetUniformLocation(m_ID, name.c_str());
+    int loc = getLocation(name);
     glUniform1i(loc, value);
 }
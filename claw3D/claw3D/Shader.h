@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
 class Shader
@@ -15,9 +16,15 @@ public:
     void setFloat(const std::string& name, float value) const;
     void setInt(const std::string& name, int value) const;
 
+private:
+    int getLocation(const std::string& name) const;
+
 private:
     unsigned int m_ID = 0;
 
+    // glGetUniformLocation se poziva samo prvi put za dato ime
+    mutable std::unordered_map<std::string, int> m_locations;
+
     static std::string loadFile(const std::string& path);
     static unsigned int compile(unsigned int type, const std::string& src);
 };
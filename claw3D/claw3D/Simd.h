@@ -0,0 +1,12 @@
+#pragma once
+
+// SSE2 je uvek dostupan na x64 (i na Win32 sa podrazumevanim /arch:SSE2), AVX samo uz /arch:AVX
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define CLAW_SIMD_SSE 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define CLAW_SIMD_AVX 1
+#include <immintrin.h>
+#endif
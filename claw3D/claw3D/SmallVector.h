@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Vektor sa N elemenata u samom objektu; tek preko N prelazi na heap.
+// Samo za trivijalno kopirajuce tipove (pokazivaci, indeksi).
+template <typename T, unsigned int N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector je samo za POD tipove");
+
+public:
+    SmallVector() = default;
+    ~SmallVector() { if (m_data != m_inline) delete[] m_data; }
+
+    SmallVector(const SmallVector& other) { assign(other); }
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+        {
+            m_size = 0;
+            assign(other);
+        }
+        return *this;
+    }
+
+    void push_back(const T& value)
+    {
+        if (m_size == m_capacity) grow(m_capacity * 2);
+        m_data[m_size++] = value;
+    }
+
+    // redosled se ne cuva (poslednji element dolazi na mesto uklonjenog)
+    bool removeSwap(const T& value)
+    {
+        for (unsigned int i = 0; i < m_size; i++)
+        {
+            if (m_data[i] == value)
+            {
+                m_data[i] = m_data[--m_size];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void removeSwapAt(unsigned int i)
+    {
+        m_data[i] = m_data[--m_size];
+    }
+
+    void clear() { m_size = 0; }
+
+    unsigned int size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool isInline() const { return m_data == m_inline; }
+
+    T& operator[](unsigned int i) { return m_data[i]; }
+    const T& operator[](unsigned int i) const { return m_data[i]; }
+
+    T* begin() { return m_data; }
+    T* end() { return m_data + m_size; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+
+private:
+    void grow(unsigned int capacity)
+    {
+        T* data = new T[capacity];
+        std::memcpy(data, m_data, m_size * sizeof(T));
+        if (m_data != m_inline) delete[] m_data;
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    void assign(const SmallVector& other)
+    {
+        if (other.m_size > m_capacity) grow(other.m_size);
+        std::memcpy(m_data, other.m_data, other.m_size * sizeof(T));
+        m_size = other.m_size;
+    }
+
+private:
+    T m_inline[N];
+    T* m_data = m_inline;
+    unsigned int m_size = 0;
+    unsigned int m_capacity = N;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Lock-free prsten za jednog proizvodjaca i jednog potrosaca. Capacity mora biti stepen dvojke.
+// Proizvodjac menja samo m_head, potrosac samo m_tail; pun prsten odbija push (pozivalac broji gubitak).
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity mora biti stepen dvojke");
+
+public:
+    bool push(const T& value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) return false;
+
+        m_items[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // najstariji element bez uklanjanja; nullptr ako je prazan (samo potrosac)
+    const T* peek() const
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return nullptr;
+        return &m_items[tail & (Capacity - 1)];
+    }
+
+    void pop()
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool empty() const { return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire); }
+
+private:
+    T m_items[Capacity];
+
+    // odvojene linije kesa: proizvodjac i potrosac ne dele liniju
+    alignas(64) std::atomic<size_t> m_head{ 0 };
+    alignas(64) std::atomic<size_t> m_tail{ 0 };
+};
@@ -0,0 +1,82 @@
+#include "StaticBatch.h"
+#include "GameObject.h"
+#include "Mesh.h"
+
+#include <algorithm>
+
+void StaticBatch::clear()
+{
+    // paketi koji jos drze stari niz ga zadrzavaju dok se ne nacrtaju
+    m_vertices.reset();
+    m_vertexCount = 0;
+    m_bounds = Aabb();
+    m_objects.clear();
+    m_sorted.clear();
+    m_snapshots.clear();
+}
+
+void StaticBatch::build(const std::vector<GameObject*>& objects)
+{
+    clear();
+
+    m_objects = objects;
+    m_sorted = objects;
+    std::sort(m_sorted.begin(), m_sorted.end());
+    m_snapshots.reserve(objects.size());
+
+    size_t total = 0;
+    for (GameObject* obj : objects)
+        total += obj->getMesh()->getVertexCount();
+
+    std::shared_ptr<std::vector<float>> vertices = std::make_shared<std::vector<float>>();
+    std::vector<float>& baked = *vertices;
+    baked.reserve(total * kStrideFloats);
+
+    for (GameObject* obj : objects)
+    {
+        const Mesh* mesh = obj->getMesh();
+        const glm::mat4 world = obj->transform.getWorldMatrix();
+        const glm::mat3 normalMat = glm::transpose(glm::inverse(glm::mat3(world)));
+
+        m_snapshots.push_back({ obj->transform.getWorldVersion(), obj->color });
+
+        const std::vector<float>& src = mesh->getVertexData();
+        const unsigned int stride = mesh->getStrideFloats();
+
+        for (unsigned int v = 0; v < mesh->getVertexCount(); v++)
+        {
+            const float* in = &src[(size_t)v * stride];
+
+            glm::vec3 p = glm::vec3(world * glm::vec4(in[0], in[1], in[2], 1.0f));
+            glm::vec3 n = glm::normalize(normalMat * glm::vec3(in[3], in[4], in[5]));
+
+            baked.push_back(p.x); baked.push_back(p.y); baked.push_back(p.z);
+            baked.push_back(n.x); baked.push_back(n.y); baked.push_back(n.z);
+            baked.push_back(obj->color.r); baked.push_back(obj->color.g); baked.push_back(obj->color.b);
+
+            m_bounds.expand(p);
+        }
+    }
+
+    m_vertexCount = (unsigned int)(baked.size() / kStrideFloats);
+    if (m_vertexCount > 0)
+        m_vertices = std::move(vertices);
+}
+
+bool StaticBatch::isStale(const std::vector<GameObject*>& objects) const
+{
+    if (objects != m_objects) return true;
+
+    for (size_t i = 0; i < m_objects.size(); i++)
+    {
+        const GameObject* obj = m_objects[i];
+        if (obj->color != m_snapshots[i].color) return true;
+        if (obj->transform.getWorldVersion() != m_snapshots[i].worldVersion) return true;
+    }
+    return false;
+}
+
+bool StaticBatch::contains(const GameObject* obj) const
+{
+    return std::binary_search(m_sorted.begin(), m_sorted.end(), obj);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+
+class GameObject;
+
+// Staticki objekti (isStatic) koji dele shader, unapred transformisani u jedan niz verteksa
+// (pozicija, normala, boja po verteksu) i nacrtani jednim pozivom.
+// Pamti verziju transforma i boju svakog objekta u trenutku pecenja; isStale() javlja da je nesto izmenjeno.
+// Samo CPU strana (simulacija): niz putuje u FramePacket-u, GL bafer pravi SceneRenderer.
+class StaticBatch
+{
+public:
+    static const unsigned int kStrideFloats = 9;    // pos3 + normal3 + color3
+
+    StaticBatch() = default;
+
+    StaticBatch(const StaticBatch&) = delete;
+    StaticBatch& operator=(const StaticBatch&) = delete;
+
+    void build(const std::vector<GameObject*>& objects);
+    void clear();
+
+    // true ako se skup objekata ili neciji transform/boja promenio od pecenja
+    bool isStale(const std::vector<GameObject*>& objects) const;
+
+    // verteksi u svetskom prostoru (model = identitet); nepromenljivi, build() pravi novi niz
+    const std::shared_ptr<const std::vector<float>>& getVertices() const { return m_vertices; }
+
+    bool empty() const { return m_vertexCount == 0; }
+    bool contains(const GameObject* obj) const;
+
+    unsigned int getObjectCount() const { return (unsigned int)m_objects.size(); }
+    unsigned int getVertexCount() const { return m_vertexCount; }
+    const Aabb& getBounds() const { return m_bounds; }
+
+private:
+    struct Snapshot
+    {
+        unsigned int worldVersion;
+        glm::vec3 color;
+    };
+
+    std::vector<GameObject*> m_objects;
+    std::vector<GameObject*> m_sorted;      // za binary_search u contains()
+    std::vector<Snapshot> m_snapshots;
+
+    std::shared_ptr<const std::vector<float>> m_vertices;
+    unsigned int m_vertexCount = 0;
+    Aabb m_bounds;
+};
@@ -0,0 +1,29 @@
+#include "Transform.h"
+
+Transform::~Transform()
+{
+    system().destroy(m_id);
+}
+
+Transform::Transform(const Transform& other)
+    : m_id(system().create(this))
+{
+    setPosition(other.getPosition());
+    setOrientation(other.getOrientation());
+    setScale(other.getScale());
+}
+
+Transform& Transform::operator=(const Transform& other)
+{
+    if (this == &other) return *this;
+
+    setPosition(other.getPosition());
+    setOrientation(other.getOrientation());
+    setScale(other.getScale());
+    return *this;
+}
+
+void Transform::setParent(Transform* newParent)
+{
+    system().setParent(m_id, newParent ? newParent->m_id : TransformSystem::kInvalid);
+}
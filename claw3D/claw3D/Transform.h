@@ -1,55 +1,50 @@
 #pragma once
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <vector>
-#include <algorithm>
+#include "TransformSystem.h"
 
+// Rucka na cvor u TransformSystem-u (TRS + kesirane matrice su tamo, u SoA nizovima).
+// Seteri samo obelezavaju cvor; svetske matrice racuna TransformSystem::update u jednom
+// prolazu, a getWorldMatrix na zahtev ako je cvor izmenjen posle poslednjeg prolaza.
 class Transform
 {
 public:
-    glm::vec3 position{ 0.0f };
-    glm::vec3 rotation{ 0.0f }; // stepeni: pitch(x), yaw(y), roll(z)
-    glm::vec3 scale{ 1.0f };
-
-    Transform* parent = nullptr;
-    std::vector<Transform*> children;
-
-    glm::mat4 getLocalMatrix() const
-    {
-        glm::mat4 model(1.0f);
-
-        model = glm::translate(model, position);
-
-        model = glm::rotate(model, glm::radians(rotation.x), { 1,0,0 });
-        model = glm::rotate(model, glm::radians(rotation.y), { 0,1,0 });
-        model = glm::rotate(model, glm::radians(rotation.z), { 0,0,1 });
-
-        model = glm::scale(model, scale);
-        return model;
-    }
-
-    glm::mat4 getWorldMatrix() const
-    {
-        if (parent)
-            return parent->getWorldMatrix() * getLocalMatrix();
-        return getLocalMatrix();
-    }
-
-    void setParent(Transform* newParent)
-    {
-        if (parent == newParent) return;
-
-        // izbaci iz starog parenta
-        if (parent)
-        {
-            auto& siblings = parent->children;
-            siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
-        }
-
-        parent = newParent;
-
-        // ubaci u novog parenta
-        if (parent)
-            parent->children.push_back(this);
-    }
+    Transform() : m_id(TransformSystem::instance().create(this)) {}
+    ~Transform();
+
+    // kopija je novi koren sa istim TRS (hijerarhiju drzi GameObject)
+    Transform(const Transform& other);
+    Transform& operator=(const Transform& other);
+
+    const glm::vec3& getPosition() const { return system().getPosition(m_id); }
+    const glm::vec3& getRotation() const { return system().getRotation(m_id); }   // stepeni: pitch(x), yaw(y), roll(z)
+    const glm::quat& getOrientation() const { return system().getOrientation(m_id); }
+    const glm::vec3& getScale() const { return system().getScale(m_id); }
+
+    void setPosition(const glm::vec3& position) { system().setPosition(m_id, position); }
+    void setRotation(const glm::vec3& rotation) { system().setRotation(m_id, rotation); }
+    void setOrientation(const glm::quat& orientation) { system().setOrientation(m_id, orientation); }
+    void setScale(const glm::vec3& scale) { system().setScale(m_id, scale); }
+
+    glm::mat4 getLocalMatrix() const { return system().getLocalMatrix(m_id); }
+    glm::mat4 getWorldMatrix() const { return system().getWorldMatrix(m_id); }
+    const Affine& getWorldAffine() const { return system().getWorldAffine(m_id); }
+
+    // raste svaki put kad se svetska matrica (ovog cvora ili predaka) promeni
+    unsigned int getWorldVersion() const { return system().getWorldVersion(m_id); }
+
+    // za crtanje izmedju dva koraka simulacije (vidi TransformSystem::storePrevious)
+    glm::mat4 getInterpolatedWorld(float alpha) const { return system().getInterpolatedWorld(m_id, alpha); }
+    // posle skoka na novo mesto: bez interpolacije do sledeceg koraka
+    void resetInterpolation() { system().resetInterpolation(m_id); }
+
+    Transform* getParent() const { return system().getParent(m_id); }
+    void setParent(Transform* newParent);
+
+    unsigned int getId() const { return m_id; }
+
+private:
+    static TransformSystem& system() { return TransformSystem::instance(); }
+
+private:
+    unsigned int m_id;
 };
@@ -0,0 +1,125 @@
+#include "TransformBench.h"
+#include "Affine.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    struct Node
+    {
+        glm::vec3 position;
+        glm::vec3 rotation;     // stepeni
+        glm::quat orientation;
+        glm::vec3 scale;
+        int parent;             // uvek manji indeks (preorder)
+    };
+
+    glm::mat4 oldLocal(const Node& n)
+    {
+        glm::mat4 model(1.0f);
+        model = glm::translate(model, n.position);
+        model = glm::rotate(model, glm::radians(n.rotation.x), { 1,0,0 });
+        model = glm::rotate(model, glm::radians(n.rotation.y), { 0,1,0 });
+        model = glm::rotate(model, glm::radians(n.rotation.z), { 0,0,1 });
+        return glm::scale(model, n.scale);
+    }
+
+    float randRange(float lo, float hi)
+    {
+        return lo + (hi - lo) * (float)std::rand() / (float)RAND_MAX;
+    }
+}
+
+void runTransformBenchmark(unsigned int nodeCount, unsigned int iterations)
+{
+    using clock = std::chrono::high_resolution_clock;
+
+    // hijerarhija slicna kandzi: vecina cvorova ima roditelja nekoliko nivoa iznad
+    std::srand(1234);
+    std::vector<Node> nodes(nodeCount);
+    for (unsigned int i = 0; i < nodeCount; i++)
+    {
+        Node& n = nodes[i];
+        n.position = { randRange(-2, 2), randRange(-2, 2), randRange(-2, 2) };
+        n.rotation = { randRange(-180, 180), randRange(-180, 180), randRange(-180, 180) };
+        n.orientation = quatFromEuler(n.rotation);
+        n.scale = { randRange(0.5f, 2), randRange(0.5f, 2), randRange(0.5f, 2) };
+        n.parent = (i % 5 == 0) ? -1 : (int)(i - 1 - std::rand() % std::min(i, 4u));
+    }
+
+    std::vector<glm::mat4> oldWorld(nodeCount);
+    std::vector<Affine> newLocal(nodeCount);
+    std::vector<Affine> newWorld(nodeCount);
+
+    // ===== STARA PUTANJA =====
+    auto t0 = clock::now();
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        for (unsigned int i = 0; i < nodeCount; i++)
+        {
+            const glm::mat4 local = oldLocal(nodes[i]);
+            oldWorld[i] = nodes[i].parent < 0 ? local : oldWorld[nodes[i].parent] * local;
+        }
+    }
+    auto t1 = clock::now();
+
+    // ===== NOVA PUTANJA =====
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        for (unsigned int i = 0; i < nodeCount; i++)
+        {
+            const Node& n = nodes[i];
+            composeAffine(n.position, n.orientation, n.scale, newLocal[i]);
+            if (n.parent < 0) newWorld[i] = newLocal[i];
+            else multiplyAffine(newWorld[n.parent], newLocal[i], newWorld[i]);
+        }
+    }
+    auto t2 = clock::now();
+
+    // ===== SAMO KOMPOZICIJA / SAMO PROIZVOD =====
+    glm::mat4 sinkOld(0.0f);
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        for (unsigned int i = 0; i < nodeCount; i++)
+            sinkOld += oldLocal(nodes[i]);
+    }
+    auto t3 = clock::now();
+
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        for (unsigned int i = 0; i < nodeCount; i++)
+            composeAffine(nodes[i].position, nodes[i].orientation, nodes[i].scale, newLocal[i]);
+    }
+    auto t4 = clock::now();
+
+    float maxError = 0.0f;
+    for (unsigned int i = 0; i < nodeCount; i++)
+    {
+        const glm::mat4 m = newWorld[i].toMat4();
+        for (int c = 0; c < 4; c++)
+        {
+            for (int r = 0; r < 4; r++)
+            {
+                float scaleRef = std::max(1.0f, std::abs(oldWorld[i][c][r]));
+                maxError = std::max(maxError, std::abs(m[c][r] - oldWorld[i][c][r]) / scaleRef);
+            }
+        }
+    }
+
+    const double perNode = 1e9 / ((double)nodeCount * iterations);
+    auto ns = [&](clock::time_point a, clock::time_point b)
+        {
+            return std::chrono::duration<double>(b - a).count() * perNode;
+        };
+
+    std::cout << "===== TRANSFORM BENCHMARK =====\n"
+        << "cvorova: " << nodeCount << ", iteracija: " << iterations << "\n"
+        << "stara (Euler + 4x4):      " << ns(t0, t1) << " ns/cvor\n"
+        << "nova (kvaternion + 3x4):  " << ns(t1, t2) << " ns/cvor\n"
+        << "  lokalna TRS stara/nova: " << ns(t2, t3) << " / " << ns(t3, t4) << " ns/cvor\n"
+        << "max relativna greska: " << maxError << " (kontrola: " << sinkOld[3][3] << ")\n";
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// Mikrobenchmark: stara putanja (Euler, translate + 3x rotate + scale, 4x4 proizvodi)
+// protiv nove (kvaternion, direktna 3x4 kompozicija, afini proizvodi).
+// Pokrece se sa: claw3D --bench-transform [brojCvorova]
+void runTransformBenchmark(unsigned int nodeCount, unsigned int iterations = 200);
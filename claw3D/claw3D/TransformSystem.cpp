@@ -0,0 +1,551 @@
+#include "TransformSystem.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace
+{
+    // ispod ovoga je jedan prolaz na glavnoj niti brzi od zakazivanja poslova
+    const unsigned int kParallelThreshold = 4096;
+
+    template <typename T>
+    void permute(std::vector<T>& v, const std::vector<unsigned int>& order)
+    {
+        std::vector<T> tmp;
+        tmp.reserve(v.size());
+        for (unsigned int old : order)
+            tmp.push_back(v[old]);
+        v.swap(tmp);
+    }
+}
+
+const unsigned int TransformSystem::kInvalid;
+
+TransformSystem& TransformSystem::instance()
+{
+    static TransformSystem system;
+    return system;
+}
+
+TransformSystem::TransformSystem(unsigned int bandCount)
+{
+    // trake se dele tek kad scena preraste kParallelThreshold
+    m_bandCount = bandCount ? bandCount : JobSystem::instance().getThreadCount();
+}
+
+unsigned int TransformSystem::create(Transform* owner)
+{
+    unsigned int id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = (unsigned int)m_sparse.size();
+        m_sparse.push_back(kInvalid);
+        m_firstChild.push_back(kInvalid);
+        m_nextSibling.push_back(kInvalid);
+        m_prevSibling.push_back(kInvalid);
+    }
+
+    m_sparse[id] = (unsigned int)m_ids.size();
+    m_firstChild[id] = m_nextSibling[id] = m_prevSibling[id] = kInvalid;
+
+    m_ids.push_back(id);
+    m_owners.push_back(owner);
+    m_position.push_back(glm::vec3(0.0f));
+    m_orientation.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    m_rotation.push_back(glm::vec3(0.0f));
+    m_scale.push_back(glm::vec3(1.0f));
+    m_local.push_back(Affine());
+    m_world.push_back(Affine());
+    m_parent.push_back(-1);
+    m_version.push_back(0);
+    m_parentVersion.push_back(0);
+    m_localDirty.push_back(0);      // identitet je vec tacna lokalna matrica
+    m_worldDirty.push_back(1);
+    m_eulerDirty.push_back(0);
+    m_prevWorld.push_back(Affine());
+    m_prevVersion.push_back(kInvalid);      // novi cvor nema prethodno stanje
+
+    // novi koren na kraju ne narusava preorder: do sledece podele po trakama ide u rep,
+    // koji update racuna na glavnoj niti posle traka
+    return id;
+}
+
+void TransformSystem::destroy(unsigned int id)
+{
+    if (id >= m_sparse.size() || m_sparse[id] == kInvalid) return;
+
+    const unsigned int index = m_sparse[id];
+
+    // deca postaju koreni (koren je ispravan bilo gde u preorder-u i u svakoj traci)
+    unlink(id);
+    for (unsigned int c = m_firstChild[id]; c != kInvalid;)
+    {
+        const unsigned int next = m_nextSibling[c];
+        m_nextSibling[c] = m_prevSibling[c] = kInvalid;
+        m_parent[m_sparse[c]] = -1;
+        m_worldDirty[m_sparse[c]] = 1;
+        c = next;
+    }
+    m_firstChild[id] = kInvalid;
+
+    // mesto ostaje prazno da se redosled i trake ne bi menjali; update ga uklanja kad
+    // praznih mesta bude mnogo (vidi needsRebuild)
+    m_ids[index] = kInvalid;
+    m_owners[index] = nullptr;
+    m_parent[index] = -1;
+    m_localDirty[index] = m_worldDirty[index] = 0;
+    m_prevVersion[index] = kInvalid;
+    m_dead++;
+
+    m_sparse[id] = kInvalid;
+    m_freeIds.push_back(id);
+}
+
+void TransformSystem::clear()
+{
+    // Transform-i scene se unistavaju posle ovoga; njihov destroy vidi nevazeci id i ne radi nista
+    m_sparse.clear();
+    m_freeIds.clear();
+    m_firstChild.clear();
+    m_nextSibling.clear();
+    m_prevSibling.clear();
+
+    m_ids.clear();
+    m_owners.clear();
+    m_position.clear();
+    m_orientation.clear();
+    m_rotation.clear();
+    m_scale.clear();
+    m_local.clear();
+    m_world.clear();
+    m_parent.clear();
+    m_version.clear();
+    m_parentVersion.clear();
+    m_localDirty.clear();
+    m_worldDirty.clear();
+    m_eulerDirty.clear();
+    m_prevWorld.clear();
+    m_prevVersion.clear();
+
+    m_prefix.clear();
+    m_bands.clear();
+    m_partitionEnd = 0;
+    m_dead = 0;
+    m_orderDirty = false;
+}
+
+void TransformSystem::link(unsigned int id, unsigned int parentId)
+{
+    const unsigned int first = m_firstChild[parentId];
+    m_nextSibling[id] = first;
+    m_prevSibling[id] = kInvalid;
+    if (first != kInvalid) m_prevSibling[first] = id;
+    m_firstChild[parentId] = id;
+}
+
+void TransformSystem::unlink(unsigned int id)
+{
+    const int p = m_parent[m_sparse[id]];
+    if (p < 0) return;
+
+    const unsigned int prev = m_prevSibling[id];
+    const unsigned int next = m_nextSibling[id];
+    if (prev != kInvalid) m_nextSibling[prev] = next;
+    else m_firstChild[m_ids[p]] = next;
+    if (next != kInvalid) m_prevSibling[next] = prev;
+
+    m_nextSibling[id] = m_prevSibling[id] = kInvalid;
+}
+
+void TransformSystem::setPosition(unsigned int id, const glm::vec3& position)
+{
+    const unsigned int i = m_sparse[id];
+    if (m_position[i] == position) return;
+
+    m_position[i] = position;
+    m_localDirty[i] = m_worldDirty[i] = 1;
+}
+
+const glm::vec3& TransformSystem::getRotation(unsigned int id)
+{
+    const unsigned int i = m_sparse[id];
+    if (m_eulerDirty[i])
+    {
+        m_rotation[i] = eulerFromQuat(m_orientation[i]);
+        m_eulerDirty[i] = 0;
+    }
+    return m_rotation[i];
+}
+
+void TransformSystem::setRotation(unsigned int id, const glm::vec3& rotation)
+{
+    const unsigned int i = m_sparse[id];
+    if (!m_eulerDirty[i] && m_rotation[i] == rotation) return;
+
+    m_rotation[i] = rotation;
+    m_orientation[i] = quatFromEuler(rotation);
+    m_eulerDirty[i] = 0;
+    m_localDirty[i] = m_worldDirty[i] = 1;
+}
+
+void TransformSystem::setOrientation(unsigned int id, const glm::quat& orientation)
+{
+    const unsigned int i = m_sparse[id];
+    const glm::quat q = glm::normalize(orientation);
+    if (m_orientation[i] == q) return;
+
+    m_orientation[i] = q;
+    m_eulerDirty[i] = 1;
+    m_localDirty[i] = m_worldDirty[i] = 1;
+}
+
+void TransformSystem::setScale(unsigned int id, const glm::vec3& scale)
+{
+    const unsigned int i = m_sparse[id];
+    if (m_scale[i] == scale) return;
+
+    m_scale[i] = scale;
+    m_localDirty[i] = m_worldDirty[i] = 1;
+}
+
+void TransformSystem::setParent(unsigned int id, unsigned int parentId)
+{
+    const unsigned int i = m_sparse[id];
+    const int p = parentId == kInvalid ? -1 : (int)m_sparse[parentId];
+    if (m_parent[i] == p) return;
+
+    unlink(id);
+    m_parent[i] = p;
+    if (p >= 0) link(id, parentId);
+    m_worldDirty[i] = 1;
+
+    // koren je ispravan bilo gde, a roditelj ispred cvora takodje, osim kad je cvor u traci
+    // (roditelj moze biti u drugoj traci); ostalo se sortira u sledecem update-u
+    if (p >= (int)i || (p >= 0 && !m_bands.empty() && i < m_partitionEnd))
+        m_orderDirty = true;
+}
+
+Transform* TransformSystem::getParent(unsigned int id) const
+{
+    const int p = m_parent[m_sparse[id]];
+    return p < 0 ? nullptr : m_owners[p];
+}
+
+const Affine& TransformSystem::getLocalAffine(unsigned int id)
+{
+    const unsigned int i = m_sparse[id];
+    if (m_localDirty[i]) computeLocal(i, m_counters);
+    return m_local[i];
+}
+
+const Affine& TransformSystem::getWorldAffine(unsigned int id)
+{
+    const unsigned int i = m_sparse[id];
+    ensureWorld(i);
+    return m_world[i];
+}
+
+unsigned int TransformSystem::getWorldVersion(unsigned int id)
+{
+    const unsigned int i = m_sparse[id];
+    ensureWorld(i);
+    return m_version[i];
+}
+
+void TransformSystem::storePrevious()
+{
+    // posle Scene::update su sve matrice tacne; izmenjen cvor (jos nije preracunat) nema sigurno
+    // prethodno stanje, pa se za njega interpolacija preskace
+    const unsigned int n = (unsigned int)m_ids.size();
+    for (unsigned int i = 0; i < n; i++)
+    {
+        const int p = m_parent[i];
+        if (m_worldDirty[i] || (p >= 0 && m_parentVersion[i] != m_version[p]))
+        {
+            m_prevVersion[i] = kInvalid;
+            continue;
+        }
+
+        m_prevWorld[i] = m_world[i];
+        m_prevVersion[i] = m_version[i];
+    }
+}
+
+glm::mat4 TransformSystem::getInterpolatedWorld(unsigned int id, float alpha)
+{
+    const unsigned int i = m_sparse[id];
+    ensureWorld(i);
+
+    // cvor koji se u poslednjem koraku nije pomerio (vecina) ide bez racunanja
+    if (alpha >= 1.0f || m_prevVersion[i] == kInvalid || m_prevVersion[i] == m_version[i])
+        return m_world[i].toMat4();
+
+    Affine blended;
+    lerpAffine(m_prevWorld[i], m_world[i], alpha, blended);
+    return blended.toMat4();
+}
+
+void TransformSystem::computeLocal(unsigned int i, Counters& counters)
+{
+    composeAffine(m_position[i], m_orientation[i], m_scale[i], m_local[i]);
+    m_localDirty[i] = 0;
+    counters.localRecomputed++;
+}
+
+bool TransformSystem::computeWorld(unsigned int i, Counters& counters)
+{
+    const int p = m_parent[i];
+
+    // cvor se racuna ako se sam menjao ili je roditelj u medjuvremenu dobio novu matricu
+    if (!m_worldDirty[i] && (p < 0 || m_parentVersion[i] == m_version[p]))
+        return false;
+
+    if (m_localDirty[i]) computeLocal(i, counters);
+
+    if (p >= 0)
+    {
+        multiplyAffine(m_world[p], m_local[i], m_world[i]);
+        m_parentVersion[i] = m_version[p];
+    }
+    else
+    {
+        m_world[i] = m_local[i];
+    }
+
+    m_version[i]++;
+    m_worldDirty[i] = 0;
+    counters.worldRecomputed++;
+    return true;
+}
+
+void TransformSystem::ensureWorld(unsigned int index)
+{
+    // lanac predaka od korena ka cvoru (hijerarhija ne mora biti sortirana); bez ogranicenja
+    // dubine, inace bi se dublji cvor racunao od zastarelih matrica predaka
+    m_chain.clear();
+    for (int n = (int)index; n >= 0; n = m_parent[n])
+        m_chain.push_back((unsigned int)n);
+
+    for (size_t k = m_chain.size() - 1; k > 0; k--)
+        computeWorld(m_chain[k], m_counters);
+
+    if (!computeWorld(index, m_counters))
+        m_counters.cacheHits++;
+}
+
+void TransformSystem::sortHierarchy()
+{
+    const unsigned int n = (unsigned int)m_ids.size();
+
+    // deca po roditelju (CSR), redosled medju bracom se cuva
+    std::vector<unsigned int> childStart(n + 1, 0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        if (m_parent[i] >= 0) childStart[m_parent[i] + 1]++;
+    }
+    for (unsigned int i = 0; i < n; i++)
+        childStart[i + 1] += childStart[i];
+
+    std::vector<unsigned int> children(childStart[n]);
+    std::vector<unsigned int> fill(childStart.begin(), childStart.end() - 1);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        if (m_parent[i] >= 0) children[fill[m_parent[i]]++] = i;
+    }
+
+    // preorder DFS od svakog korena
+    std::vector<unsigned int> order;
+    order.reserve(n);
+    std::vector<unsigned int> stack;
+    for (unsigned int root = 0; root < n; root++)
+    {
+        if (m_parent[root] >= 0 || m_ids[root] == kInvalid) continue;
+
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            unsigned int node = stack.back();
+            stack.pop_back();
+            order.push_back(node);
+
+            for (unsigned int c = childStart[node + 1]; c > childStart[node]; c--)
+                stack.push_back(children[c - 1]);
+        }
+    }
+
+    // prazna mesta nisu u order-u, pa se nizovi ujedno sabijaju
+    const unsigned int live = (unsigned int)order.size();
+    std::vector<int> remap(n);
+    for (unsigned int i = 0; i < live; i++)
+        remap[order[i]] = (int)i;
+
+    std::vector<int> parent(live);
+    for (unsigned int i = 0; i < live; i++)
+    {
+        int p = m_parent[order[i]];
+        parent[i] = p < 0 ? -1 : remap[p];
+    }
+    m_parent.swap(parent);
+
+    permute(m_ids, order);
+    permute(m_owners, order);
+    permute(m_position, order);
+    permute(m_orientation, order);
+    permute(m_rotation, order);
+    permute(m_scale, order);
+    permute(m_local, order);
+    permute(m_world, order);
+    permute(m_version, order);
+    permute(m_parentVersion, order);
+    permute(m_localDirty, order);
+    permute(m_worldDirty, order);
+    permute(m_eulerDirty, order);
+    permute(m_prevWorld, order);
+    permute(m_prevVersion, order);
+
+    for (unsigned int i = 0; i < live; i++)
+        m_sparse[m_ids[i]] = i;
+
+    m_dead = 0;
+    m_orderDirty = false;
+}
+
+void TransformSystem::buildPartition()
+{
+    m_prefix.clear();
+    m_bands.clear();
+
+    const unsigned int n = (unsigned int)m_ids.size();
+    if (n < kParallelThreshold || m_bandCount < 2) return;
+
+    // u preorder-u podstablo cvora i je [i, i + size[i])
+    std::vector<unsigned int> size(n, 1);
+    for (unsigned int i = n; i-- > 0;)
+    {
+        if (m_parent[i] >= 0) size[m_parent[i]] += size[i];
+    }
+
+    const unsigned int bandCount = m_bandCount;
+    const unsigned int target = n / bandCount;
+
+    // preveliko podstablo: koren ide u prefiks (glavna nit), deca postaju zasebne jedinice
+    std::vector<Range> units;
+    std::vector<unsigned int> queue;
+    for (unsigned int i = 0; i < n; i += size[i])
+        queue.push_back(i);
+
+    for (size_t q = 0; q < queue.size(); q++)
+    {
+        unsigned int root = queue[q];
+        if (size[root] <= target || size[root] == 1)
+        {
+            units.push_back({ root, root + size[root] });
+            continue;
+        }
+
+        m_prefix.push_back(root);
+        for (unsigned int c = root + 1; c < root + size[root]; c += size[c])
+            queue.push_back(c);
+    }
+
+    // najveca jedinica u najmanje opterecenu traku
+    std::sort(units.begin(), units.end(),
+        [](const Range& a, const Range& b) { return (a.end - a.begin) > (b.end - b.begin); });
+
+    m_bands.resize(bandCount);
+    std::vector<unsigned int> load(bandCount, 0);
+    for (const Range& r : units)
+    {
+        unsigned int band = (unsigned int)(std::min_element(load.begin(), load.end()) - load.begin());
+        m_bands[band].push_back(r);
+        load[band] += r.end - r.begin;
+    }
+
+    for (auto& band : m_bands)
+    {
+        std::sort(band.begin(), band.end(),
+            [](const Range& a, const Range& b) { return a.begin < b.begin; });
+    }
+}
+
+bool TransformSystem::needsRebuild() const
+{
+    // rep i prazna mesta se skupljaju bez sortiranja; kad ih bude cetvrtina svih cvorova,
+    // jedan sort ih sabija i deli trake iznova (amortizovano O(1) po create/destroy)
+    const unsigned int n = (unsigned int)m_ids.size();
+    return m_orderDirty || (n - m_partitionEnd) + m_dead > n / 4;
+}
+
+void TransformSystem::update()
+{
+    if (m_ids.empty()) return;
+
+    if (needsRebuild())
+    {
+        sortHierarchy();
+        buildPartition();
+        m_partitionEnd = (unsigned int)m_ids.size();
+    }
+
+    // prazna mesta se ne racunaju, pa ih prolazi broje kao cacheHits; oduzimaju se na kraju
+    const unsigned int n = (unsigned int)m_ids.size();
+    if (m_bands.empty())
+    {
+        unsigned int computed = 0;
+        for (unsigned int i = 0; i < n; i++)
+        {
+            if (computeWorld(i, m_counters)) computed++;
+        }
+        m_counters.cacheHits += n - m_dead - computed;
+        return;
+    }
+
+    unsigned int prefixComputed = 0;
+    for (unsigned int i : m_prefix)
+    {
+        if (computeWorld(i, m_counters)) prefixComputed++;
+    }
+    m_counters.cacheHits += (unsigned int)m_prefix.size() - prefixComputed;
+
+    // trake su nezavisne (disjunktna podstabla, preci su vec izracunati u prefiksu)
+    m_bandCounters.assign(m_bands.size(), Counters());
+    JobSystem::instance().parallelFor((unsigned int)m_bands.size(), 1,
+        [this](unsigned int begin, unsigned int end)
+        {
+            for (unsigned int band = begin; band < end; band++)
+                updateBand(band);
+        });
+
+    for (const Counters& c : m_bandCounters)
+    {
+        m_counters.localRecomputed += c.localRecomputed;
+        m_counters.worldRecomputed += c.worldRecomputed;
+        m_counters.cacheHits += c.cacheHits;
+    }
+
+    // rep: cvorovi napravljeni posle poslednje podele (roditelji su ispred, vec izracunati)
+    for (unsigned int i = m_partitionEnd; i < n; i++)
+    {
+        if (!computeWorld(i, m_counters)) m_counters.cacheHits++;
+    }
+    m_counters.cacheHits -= m_dead;
+}
+
+void TransformSystem::updateBand(unsigned int band)
+{
+    if (band >= m_bands.size()) return;
+
+    Counters& counters = m_bandCounters[band];
+    for (const Range& r : m_bands[band])
+    {
+        for (unsigned int i = r.begin; i < r.end; i++)
+        {
+            if (!computeWorld(i, counters)) counters.cacheHits++;
+        }
+    }
+}
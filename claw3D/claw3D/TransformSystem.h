@@ -0,0 +1,141 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "Affine.h"
+
+class Transform;
+
+// Svi transformi u strukturi nizova (SoA), sortirani tako da roditelj uvek prethodi deci
+// (preorder), pa update() racuna sve svetske matrice u jednom linearnom prolazu.
+// Za velike scene prolaz se deli po podstablima na trake koje izvrsava JobSystem.
+// Transform je samo rucka (id); id je stabilan, gusti indeks se menja pri sortiranju.
+// create dodaje koren na kraj, a destroy ostavlja prazno mesto, pa ni jedno ni drugo ne
+// sortira; sort ostaje za setParent koji narusava redosled i za povremeno sabijanje.
+class TransformSystem
+{
+public:
+    static const unsigned int kInvalid = ~0u;
+
+    // brojaci od poslednjeg resetCounters() (Application ih resetuje svaki frejm)
+    struct Counters
+    {
+        unsigned int localRecomputed = 0;
+        unsigned int worldRecomputed = 0;
+        unsigned int cacheHits = 0;         // getWorldMatrix bez ponovnog racunanja
+    };
+
+    static TransformSystem& instance();
+
+    explicit TransformSystem(unsigned int bandCount = 0);   // 0 = broj niti JobSystem-a
+
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    unsigned int create(Transform* owner);
+    void destroy(unsigned int id);
+
+    // brise sve cvorove odjednom (Scene::clear); destroy za vec obrisan id posle toga ne radi nista
+    void clear();
+
+    const glm::vec3& getPosition(unsigned int id) const { return m_position[m_sparse[id]]; }
+    const glm::quat& getOrientation(unsigned int id) const { return m_orientation[m_sparse[id]]; }
+    const glm::vec3& getScale(unsigned int id) const { return m_scale[m_sparse[id]]; }
+
+    // Euler stepeni; posle setOrientation se izvode iz kvaterniona na zahtev
+    const glm::vec3& getRotation(unsigned int id);
+
+    void setPosition(unsigned int id, const glm::vec3& position);
+    void setRotation(unsigned int id, const glm::vec3& rotation);
+    void setOrientation(unsigned int id, const glm::quat& orientation);
+    void setScale(unsigned int id, const glm::vec3& scale);
+
+    // parentId = kInvalid -> koren
+    void setParent(unsigned int id, unsigned int parentId);
+    Transform* getParent(unsigned int id) const;
+
+    // racunaju se na zahtev ako update() jos nije prosao posle izmene
+    glm::mat4 getLocalMatrix(unsigned int id) { return getLocalAffine(id).toMat4(); }
+    glm::mat4 getWorldMatrix(unsigned int id) { return getWorldAffine(id).toMat4(); }
+    const Affine& getLocalAffine(unsigned int id);
+    const Affine& getWorldAffine(unsigned int id);
+    unsigned int getWorldVersion(unsigned int id);
+
+    // ===== INTERPOLACIJA (fiksni korak simulacije) =====
+    // pamti svetske matrice pre koraka; zove se na pocetku svakog koraka simulacije
+    void storePrevious();
+    // izmedju matrice pre poslednjeg koraka i tekuce (alpha = 1 -> tekuca)
+    glm::mat4 getInterpolatedWorld(unsigned int id, float alpha);
+    // teleport: cvor se do sledeceg koraka crta na tekucem mestu, bez "prevlacenja"
+    void resetInterpolation(unsigned int id) { m_prevVersion[m_sparse[id]] = kInvalid; }
+
+    // linearni prolaz kroz sve cvorove (sortira hijerarhiju ako se menjala)
+    void update();
+
+    unsigned int getNodeCount() const { return (unsigned int)m_ids.size() - m_dead; }
+    unsigned int getBandCount() const { return m_bandCount; }
+
+    const Counters& getCounters() const { return m_counters; }
+    void resetCounters() { m_counters = Counters(); }
+
+private:
+    struct Range
+    {
+        unsigned int begin;
+        unsigned int end;
+    };
+
+    void link(unsigned int id, unsigned int parentId);
+    void unlink(unsigned int id);
+    bool needsRebuild() const;
+    void sortHierarchy();
+    void buildPartition();
+    void ensureWorld(unsigned int index);
+    bool computeWorld(unsigned int index, Counters& counters);
+    void computeLocal(unsigned int index, Counters& counters);
+    void updateBand(unsigned int band);
+
+private:
+    // id -> gusti indeks; oslobodjeni id-jevi se ponovo koriste
+    std::vector<unsigned int> m_sparse;
+    std::vector<unsigned int> m_freeIds;
+
+    // deca po id-ju (prvo dete + dvostruko povezana braca): destroy i setParent diraju samo
+    // decu cvora, bez prolaza kroz sve cvorove; kInvalid = nema
+    std::vector<unsigned int> m_firstChild;
+    std::vector<unsigned int> m_nextSibling;
+    std::vector<unsigned int> m_prevSibling;
+
+    // ===== SoA (gusti indeks) =====
+    std::vector<unsigned int> m_ids;            // kInvalid = prazno mesto posle destroy
+    std::vector<Transform*> m_owners;
+    std::vector<glm::vec3> m_position;
+    std::vector<glm::quat> m_orientation;
+    std::vector<glm::vec3> m_rotation;          // Euler stepeni (kes za getRotation)
+    std::vector<glm::vec3> m_scale;
+    std::vector<Affine> m_local;
+    std::vector<Affine> m_world;
+    std::vector<int> m_parent;                  // gusti indeks roditelja, -1 = koren
+    std::vector<unsigned int> m_version;        // raste pri svakom racunanju svetske matrice
+    std::vector<unsigned int> m_parentVersion;  // verzija roditelja pri poslednjem racunanju
+    std::vector<unsigned char> m_localDirty;
+    std::vector<unsigned char> m_worldDirty;
+    std::vector<unsigned char> m_eulerDirty;
+    std::vector<Affine> m_prevWorld;            // stanje pre tekuceg koraka (storePrevious)
+    std::vector<unsigned int> m_prevVersion;    // m_version u tom trenutku; kInvalid = bez interpolacije
+
+    bool m_orderDirty = false;
+    unsigned int m_dead = 0;                    // prazna mesta u nizovima
+    unsigned int m_partitionEnd = 0;            // [m_partitionEnd, n) = rep, van podele po trakama
+
+    // podela za paralelni prolaz: preci velikih podstabala (glavna nit, redom),
+    // pa nezavisni opsezi podstabala po traci
+    std::vector<unsigned int> m_prefix;
+    std::vector<std::vector<Range>> m_bands;
+    std::vector<Counters> m_bandCounters;
+
+    Counters m_counters;
+
+    std::vector<unsigned int> m_chain;          // ensureWorld: preci cvora (ponovo koriscen bafer)
+
+    unsigned int m_bandCount = 1;
+};
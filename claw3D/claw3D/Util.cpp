@@ -1,4 +1,6 @@
 #include "Util.h";
+#include "GLState.h"
+#include "Profiler.h"
 
 #define _CRT_SECURE_NO_WARNINGS
 #include <fstream>
@@ -99,6 +101,8 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
 
 unsigned loadImageToTexture(const char* filePath)
 {
+    PROFILE_ZONE("loadImageToTexture");
+
     int width, height, channels;
     unsigned char* data = stbi_load(filePath, &width, &height, &channels, 0);
 
@@ -116,7 +120,7 @@ unsigned loadImageToTexture(const char* filePath)
 
     unsigned int texture;
     glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
+    GLState::bindTexture2D(0, texture);
 
     glTexImage2D(
         GL_TEXTURE_2D,
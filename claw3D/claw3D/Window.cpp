@@ -1,9 +1,19 @@
 ﻿#include "Window.h"
 
+#include "GLState.h"
+#include "Profiler.h"
+
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
 
+static void setContextHints()
+{
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+}
+
 Window::Window() : m_window(nullptr) {}
 
 Window::~Window()
@@ -22,9 +32,7 @@ bool Window::create(int width, int height, const char* title)
         return false;
     }
 
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    setContextHints();
 
     GLFWmonitor* monitor = glfwGetPrimaryMonitor();
     const GLFWvidmode* mode = glfwGetVideoMode(monitor);
@@ -44,6 +52,93 @@ bool Window::create(int width, int height, const char* title)
         return false;
     }
 
+    m_width = mode->width;
+    m_height = mode->height;
+    m_refreshRate = mode->refreshRate > 0 ? mode->refreshRate : 60;
+
+    if (!initContext())
+        return false;
+
+    glfwSwapInterval(0);
+
+    return true;
+}
+
+bool Window::createHeadless(int width, int height, const char* title)
+{
+    // bez prikaza: null platforma (GLFW 3.4) sa softverskim kontekstom (OSMesa, EGL surfaceless);
+    // ako nijedan ne uspe, nevidljiv prozor na obicnoj platformi (drajver, ali bez monitora)
+    struct Backend { int platform; int api; const char* name; };
+    const Backend backends[] = {
+        { GLFW_PLATFORM_NULL, GLFW_OSMESA_CONTEXT_API, "OSMesa" },
+        { GLFW_PLATFORM_NULL, GLFW_EGL_CONTEXT_API, "EGL" },
+        { GLFW_ANY_PLATFORM, GLFW_NATIVE_CONTEXT_API, "hidden window" },
+    };
+
+    const char* backendName = nullptr;
+    for (const Backend& backend : backends)
+    {
+        if (backend.platform != GLFW_ANY_PLATFORM && !glfwPlatformSupported(backend.platform))
+            continue;
+
+        glfwInitHint(GLFW_PLATFORM, backend.platform);
+        if (!glfwInit())
+            continue;
+
+        setContextHints();
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, backend.api);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        m_window = glfwCreateWindow(width, height, title, nullptr, nullptr);
+        if (m_window)
+        {
+            backendName = backend.name;
+            break;
+        }
+        glfwTerminate();
+    }
+
+    if (!m_window)
+    {
+        std::cerr << "Headless context creation failed\n";
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    if (!initContext())
+        return false;
+
+    // "ekran" je FBO zadate rezolucije; OitPass i ostali ga vezu preko GLState-a umesto 0
+    glGenRenderbuffers(1, &m_colorRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    // isti format kao dubina OitPass-a (blit dubine zahteva poklapanje)
+    glGenRenderbuffers(1, &m_depthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorRBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRBO);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "Headless framebuffer incomplete\n";
+        return false;
+    }
+    GLState::setDefaultFramebuffer(m_FBO);
+    m_headless = true;
+
+    std::cout << "Headless: " << backendName << ", " << width << "x" << height
+        << ", " << (const char*)glGetString(GL_RENDERER) << "\n";
+    return true;
+}
+
+bool Window::initContext()
+{
     glfwMakeContextCurrent(m_window);
 
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -52,21 +147,44 @@ bool Window::create(int width, int height, const char* title)
         return false;
     }
 
-    glViewport(0, 0, mode->width, mode->height);
-
-    glfwSwapInterval(0);
-
+    glViewport(0, 0, m_width, m_height);
     return true;
 }
 
 
+VSync Window::setVSync(VSync mode)
+{
+    if (mode == VSync::Adaptive &&
+        !glfwExtensionSupported("WGL_EXT_swap_control_tear") &&
+        !glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+    {
+        mode = VSync::On;
+    }
+
+    glfwSwapInterval(mode == VSync::Adaptive ? -1 : (mode == VSync::On ? 1 : 0));
+    return mode;
+}
+
 void Window::pollEvents()
 {
     glfwPollEvents();
 }
 
+void Window::waitEvents(double timeout)
+{
+    glfwWaitEventsTimeout(timeout);
+}
+
 void Window::swapBuffers()
 {
+    PROFILE_ZONE("swapBuffers");
+
+    // nema prikaza: ceka da GPU zavrsi frejm, pa merenje frejma ukljucuje i GPU
+    if (m_headless)
+    {
+        glFinish();
+        return;
+    }
     glfwSwapBuffers(m_window);
 }
 
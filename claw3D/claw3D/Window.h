@@ -2,6 +2,9 @@
 
 struct GLFWwindow;
 
+// Adaptive: vsync dok frejm stize na vreme, bez cekanja kad zakasni (swap_control_tear)
+enum class VSync { Off, On, Adaptive };
+
 class Window
 {
 public:
@@ -9,12 +12,37 @@ public:
     ~Window();
 
     bool create(int width, int height, const char* title);
+    // bez monitora i prikaza (--headless): offscreen kontekst, crta se u FBO width x height;
+    // swapBuffers() tada samo ceka da GPU zavrsi frejm
+    bool createHeadless(int width, int height, const char* title);
+    bool isHeadless() const { return m_headless; }
     void pollEvents();
+    // kao pollEvents, ali spava dok ne stigne dogadjaj ili ne istekne timeout (sekunde)
+    void waitEvents(double timeout);
     void swapBuffers();
 
     bool shouldClose() const;
     GLFWwindow* getHandle() const;
 
+    // na niti koja drzi kontekst; vraca stvarno ukljucen rezim (Adaptive -> On bez ekstenzije)
+    VSync setVSync(VSync mode);
+    int getRefreshRate() const { return m_refreshRate; }
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+private:
+    bool initContext();
+
 private:
     GLFWwindow* m_window;
+    int m_width = 0;
+    int m_height = 0;
+    int m_refreshRate = 60;
+
+    // headless: FBO umesto podrazumevanog framebuffer-a (brise se zajedno sa kontekstom)
+    bool m_headless = false;
+    unsigned int m_FBO = 0;
+    unsigned int m_colorRBO = 0;
+    unsigned int m_depthRBO = 0;
 };
@@ -1,10 +1,134 @@
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
 
 #include "Application.h"
+#include "TransformBench.h"
+#include "JobSelfTest.h"
+#include "SceneFile.h"
 
-int main()
+int main(int argc, char** argv)
 {
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--bench-transform") == 0)
+        {
+            unsigned int nodes = (i + 1 < argc) ? (unsigned int)std::atoi(argv[i + 1]) : 10000u;
+            runTransformBenchmark(nodes > 0 ? nodes : 10000u);
+            return 0;
+        }
+
+        // provera rasporedjivaca poslova (najbolje u TSan buildu)
+        if (std::strcmp(argv[i], "--selftest-jobs") == 0)
+        {
+            unsigned int iterations = (i + 1 < argc) ? (unsigned int)std::atoi(argv[i + 1]) : 2000u;
+            return runJobSelfTest(iterations > 0 ? iterations : 2000u) ? 0 : 1;
+        }
+
+        // offline konverter scene: --bake-scene scenes/cabinet.txt scenes/cabinet.scn
+        if (std::strcmp(argv[i], "--bake-scene") == 0)
+        {
+            if (i + 2 >= argc)
+            {
+                std::cerr << "usage: claw3D --bake-scene <in.txt> <out.scn>\n";
+                return 1;
+            }
+
+            std::string error;
+            if (!compileSceneText(argv[i + 1], argv[i + 2], error))
+            {
+                std::cerr << error << "\n";
+                return 1;
+            }
+            std::cout << "Baked " << argv[i + 1] << " -> " << argv[i + 2] << "\n";
+            return 0;
+        }
+    }
+
     Application app;
+    for (int i = 1; i < argc; i++)
+    {
+        // pod arkade: N automata iz istog prefab-a
+        if (std::strcmp(argv[i], "--cabinets") == 0 && i + 1 < argc)
+            app.setCabinetCount((unsigned int)std::atoi(argv[i + 1]));
+
+        // ritam: --fps N (0 = bez ogranicenja), --vsync off|on|adaptive, --late-latch
+        if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+            app.setFrameRate((float)std::atof(argv[i + 1]));
+
+        if (std::strcmp(argv[i], "--vsync") == 0 && i + 1 < argc)
+        {
+            const char* mode = argv[i + 1];
+            app.setVSync(std::strcmp(mode, "adaptive") == 0 ? VSync::Adaptive :
+                (std::strcmp(mode, "on") == 0 ? VSync::On : VSync::Off));
+        }
+
+        if (std::strcmp(argv[i], "--late-latch") == 0)
+            app.setLateLatching(true);
+
+        // bez monitora: --headless [WxH] (podrazumevano 1280x720), obicno uz --frames N
+        if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            int width = 1280, height = 720;
+            if (i + 1 < argc)
+            {
+                // "WxH"; sve drugo je sledeca opcija
+                char* end = nullptr;
+                const long w = std::strtol(argv[i + 1], &end, 10);
+                if (end != argv[i + 1] && (*end == 'x' || *end == 'X'))
+                {
+                    const char* hs = end + 1;
+                    const long h = std::strtol(hs, &end, 10);
+                    if (end != hs && *end == '\0')
+                    {
+                        width = (int)w;
+                        height = (int)h;
+                        i++;
+                    }
+                }
+            }
+            app.setHeadless(width > 0 ? width : 1280, height > 0 ? height : 720);
+        }
+
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            app.setFrameLimit((unsigned int)std::atoi(argv[i + 1]));
+
+        // ponovljivo merenje: --scenario scenarios/x.txt --report out.json
+        // (izvestaj ide samo u fajl: stdout mesa JSON sa ostalim ispisom aplikacije)
+        if (std::strcmp(argv[i], "--scenario") == 0 && i + 1 < argc)
+        {
+            std::string report;
+            for (int j = i + 2; j + 1 < argc; j++)
+                if (std::strcmp(argv[j], "--report") == 0) report = argv[j + 1];
+            if (report.empty())
+            {
+                std::cerr << "usage: claw3D --scenario <file> --report <out.json>\n";
+                return 1;
+            }
+            app.setScenario(argv[i + 1], report);
+        }
+
+        // CPU profajler: Chrome trace (chrome://tracing, ui.perfetto.dev) na izlazu i na F5
+        if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+            app.setProfileOutput(argv[i + 1]);
+
+        // frejmovi bez promene se ne crtaju; u mirovanju provera N puta u sekundi
+        if (std::strcmp(argv[i], "--idle-fps") == 0 && i + 1 < argc)
+            app.setIdleRate((float)std::atof(argv[i + 1]));
+
+        // fiksni korak simulacije u Hz (podrazumevano 60)
+        if (std::strcmp(argv[i], "--sim-hz") == 0 && i + 1 < argc)
+            app.setSimulationRate((unsigned int)std::atoi(argv[i + 1]));
+
+        // GL na posebnoj niti; opciono 2 (simulacija ceka crtanje) ili 3 (nikad ne ceka) paketa
+        if (std::strcmp(argv[i], "--render-thread") == 0)
+        {
+            unsigned int buffers = 3;
+            if (i + 1 < argc && (std::strcmp(argv[i + 1], "2") == 0 || std::strcmp(argv[i + 1], "3") == 0))
+                buffers = (unsigned int)std::atoi(argv[++i]);
+            app.setRenderThread(true, buffers);
+        }
+    }
     app.run();
     return 0;
 }
@@ -0,0 +1,24 @@
+#version 330 core
+
+// staticka geometrija: verteksi su vec u svetskom prostoru, boja po verteksu
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec3 aColor;
+
+uniform mat4 u_View;
+uniform mat4 u_Projection;
+
+out vec3 v_FragPos;
+out vec3 v_Normal;
+out vec2 v_TexCoord;
+out vec3 v_Color;
+
+void main()
+{
+    v_FragPos = aPos;
+    v_Normal = normalize(aNormal);
+    v_TexCoord = vec2(0.0);
+    v_Color = aColor;
+
+    gl_Position = u_Projection * u_View * vec4(aPos, 1.0);
+}
@@ -5,8 +5,7 @@ out vec4 FragColor;
 in vec3 v_FragPos;
 in vec3 v_Normal;
 in vec2 v_TexCoord;   
-
-uniform vec3 u_ObjectColor;
+in vec3 v_Color;
 
 uniform vec3 u_LightPos;
 uniform vec3 u_LightColor;
@@ -25,7 +24,7 @@ void main()
     vec3 N = normalize(v_Normal);
     vec3 L = normalize(u_LightPos - v_FragPos);
 
-    vec3 baseColor = u_ObjectColor;
+    vec3 baseColor = v_Color;
 
     if (u_UseTexture == 1)
     {
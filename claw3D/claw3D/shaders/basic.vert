@@ -7,10 +7,12 @@ layout (location = 2) in vec2 aTexCoord;
 uniform mat4 u_Model;
 uniform mat4 u_View;
 uniform mat4 u_Projection;
+uniform vec3 u_ObjectColor;
 
 out vec3 v_FragPos;
 out vec3 v_Normal;
 out vec2 v_TexCoord;   
+out vec3 v_Color;
 
 void main()
 {
@@ -21,6 +23,7 @@ void main()
     v_Normal = normalize(normalMat * aNormal);
 
     v_TexCoord = aTexCoord;  
+    v_Color = u_ObjectColor;
 
     gl_Position = u_Projection * u_View * worldPos;
 }
@@ -0,0 +1,31 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+
+// po-instanci podaci (MeshInstance): model matrica + boja
+layout (location = 3) in mat4 aModel;
+layout (location = 7) in vec4 aColor;
+
+uniform mat4 u_View;
+uniform mat4 u_Projection;
+
+out vec3 v_FragPos;
+out vec3 v_Normal;
+out vec2 v_TexCoord;
+out vec3 v_Color;
+
+void main()
+{
+    vec4 worldPos = aModel * vec4(aPos, 1.0);
+    v_FragPos = worldPos.xyz;
+
+    mat3 normalMat = mat3(transpose(inverse(aModel)));
+    v_Normal = normalize(normalMat * aNormal);
+
+    v_TexCoord = aTexCoord;
+    v_Color = aColor.rgb;
+
+    gl_Position = u_Projection * u_View * worldPos;
+}
@@ -0,0 +1,58 @@
+#version 330 core
+
+// Weighted blended OIT (McGuire & Bavoil 2013), varijanta sa jednom blend funkcijom (GL 3.3):
+// glBlendFuncSeparate(ONE, ONE, ZERO, ONE_MINUS_SRC_ALPHA)
+//   target 0: rgb = sum(C * a * w), a = prod(1 - a)  (revealage)
+//   target 1: r   = sum(a * w)
+layout (location = 0) out vec4 o_Accum;
+layout (location = 1) out vec4 o_Weight;
+
+in vec3 v_FragPos;
+in vec3 v_Normal;
+in vec2 v_TexCoord;
+in vec3 v_Color;
+
+uniform vec3 u_LightPos;
+uniform vec3 u_LightColor;
+uniform vec3 u_AmbientColor;
+uniform float u_AmbientStrength;
+uniform vec3 u_ViewPos;
+
+uniform float u_Shininess;
+uniform float u_Alpha;
+
+uniform sampler2D u_Texture;
+uniform int u_UseTexture;
+
+void main()
+{
+    vec3 N = normalize(v_Normal);
+    vec3 L = normalize(u_LightPos - v_FragPos);
+
+    vec3 baseColor = v_Color;
+
+    if (u_UseTexture == 1)
+    {
+        baseColor = texture(u_Texture, v_TexCoord).rgb;
+    }
+
+    vec3 ambient = u_AmbientStrength * u_AmbientColor;
+
+    float diff = max(dot(N, L), 0.0);
+    vec3 diffuse = diff * u_LightColor;
+
+    vec3 V = normalize(u_ViewPos - v_FragPos);
+    vec3 H = normalize(L + V);
+    float spec = pow(max(dot(N, H), 0.0), u_Shininess);
+    vec3 specular = 0.35 * spec * u_LightColor;
+
+    vec3 color = (ambient + diffuse) * baseColor + specular;
+    float a = u_Alpha;
+
+    // tezina po dubini (jednacina 10 iz rada)
+    float z = gl_FragCoord.z;
+    float w = clamp(pow(min(1.0, a * 10.0) + 0.01, 3.0) * 1e8 * pow(1.0 - z * 0.9, 3.0), 1e-2, 3e3);
+
+    o_Accum = vec4(color * a * w, a);
+    o_Weight = vec4(a * w, 0.0, 0.0, a);
+}
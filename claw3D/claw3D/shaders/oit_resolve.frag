@@ -0,0 +1,24 @@
+#version 330 core
+
+out vec4 FragColor;
+
+uniform sampler2D u_Accum;
+uniform sampler2D u_Weight;
+
+void main()
+{
+    ivec2 coord = ivec2(gl_FragCoord.xy);
+
+    vec4 accum = texelFetch(u_Accum, coord, 0);
+    float revealage = accum.a;
+
+    // nista providno na ovom pikselu
+    if (revealage >= 0.9999)
+        discard;
+
+    float weight = texelFetch(u_Weight, coord, 0).r;
+    vec3 average = accum.rgb / max(weight, 1e-5);
+
+    // blend (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) preko neprovidne slike
+    FragColor = vec4(average, 1.0 - revealage);
+}